@@ -193,6 +193,8 @@ ConsumerWindow::OnContentObject (const Ptr<const ContentObject> &contentObject,
                                      Ptr<Packet> payload)
 {
   Consumer::OnContentObject (contentObject, payload);
+  if (!contentObject->GetName ().HasSeqNum ())
+    return; // not a response to our Interest
 
   if (m_mimd) { //MIMD
     m_window = m_window + 1;
@@ -219,6 +221,8 @@ void
 ConsumerWindow::OnNack (const Ptr<const Interest> &interest, Ptr<Packet> payload)
 {
   Consumer::OnNack (interest, payload);
+  if (!interest->GetName ().HasSeqNum ())
+    return; // not a response to our Interest
 
   if (m_inFlight > static_cast<uint32_t> (0)) m_inFlight--;
 
@@ -176,7 +176,7 @@ ConsumerZipfMandelbrot::SendPacket() {
 
   //
   Ptr<Name> nameWithSequence = Create<Name> (m_interestName);
-  (*nameWithSequence) (seq);
+  nameWithSequence->AppendSeqNum (seq);
   //
 
   Interest interestHeader;
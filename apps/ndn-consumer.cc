@@ -36,7 +36,6 @@
 #include "ns3/ndnSIM/utils/ndn-rtt-mean-deviation.h"
 
 #include <boost/ref.hpp>
-#include <boost/lexical_cast.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 
@@ -198,7 +197,7 @@ Consumer::SendPacket ()
 
   //
   Ptr<Name> nameWithSequence = Create<Name> (m_interestName);
-  (*nameWithSequence) (seq);
+  nameWithSequence->AppendSeqNum (seq);
   //
 
   Interest interestHeader;
@@ -241,7 +240,13 @@ Consumer::OnContentObject (const Ptr<const ContentObject> &contentObject,
 
   // NS_LOG_INFO ("Received content object: " << boost::cref(*contentObject));
 
-  uint32_t seq = boost::lexical_cast<uint32_t> (contentObject->GetName ().GetComponents ().back ());
+  if (!contentObject->GetName ().HasSeqNum ())
+    {
+      NS_LOG_DEBUG ("Ignoring DATA without sequence number: " << contentObject->GetName ());
+      return;
+    }
+
+  uint32_t seq = contentObject->GetName ().GetLastSeqNum ();
   NS_LOG_INFO ("< DATA for " << seq);
 
   int hopCount = -1;
@@ -285,7 +290,13 @@ Consumer::OnNack (const Ptr<const Interest> &interest, Ptr<Packet> origPacket)
   // NS_LOG_FUNCTION (interest->GetName ());
 
   // NS_LOG_INFO ("Received NACK: " << boost::cref(*interest));
-  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetComponents ().back ());
+  if (!interest->GetName ().HasSeqNum ())
+    {
+      NS_LOG_DEBUG ("Ignoring NACK without sequence number: " << interest->GetName ());
+      return;
+    }
+
+  uint32_t seq = interest->GetName ().GetLastSeqNum ();
   NS_LOG_INFO ("< NACK for " << seq);
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << "NACK for " << seq << "\n";
 
@@ -15,7 +15,6 @@
 #include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
-#include <boost/lexical_cast.hpp>
 
 namespace ll = boost::lambda;
 
@@ -54,7 +53,13 @@ PartialProducer::PartialProducer ()
 void
 PartialProducer::OnInterest (const Ptr<const Interest> &interest, Ptr<Packet> origPacket)
 {
-  uint32_t seq = boost::lexical_cast<uint32_t>(interest->GetName().GetLastComponent());
+  if (!interest->GetName ().HasSeqNum ())
+    {
+      NS_LOG_DEBUG ("Ignoring Interest without sequence number: " << interest->GetName ());
+      return;
+    }
+
+  uint32_t seq = interest->GetName ().GetLastSeqNum ();
   if (seq % m_dividend == m_remainder) {
     Producer::OnInterest (interest, origPacket);
   }
@@ -340,6 +340,8 @@ def register_types_ns3_ndn(module):
     module.add_class('FaceContainer', parent=root_module['ns3::SimpleRefCount< ns3::ndn::FaceContainer, ns3::empty, ns3::DefaultDeleter<ns3::ndn::FaceContainer> >'])
     ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib [class]
     module.add_class('Fib', parent=root_module['ns3::Object'])
+    ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib::Route [struct]
+    module.add_class('Route', outer_class=root_module['ns3::ndn::Fib'])
     ## ndn-forwarding-strategy.h (module 'ndnSIM'): ns3::ndn::ForwardingStrategy [class]
     module.add_class('ForwardingStrategy', parent=root_module['ns3::Object'])
     ## ndn-global-routing-helper.h (module 'ndnSIM'): ns3::ndn::GlobalRoutingHelper [class]
@@ -360,10 +362,14 @@ def register_types_ns3_ndn(module):
     module.add_class('Limits', parent=root_module['ns3::Object'])
     ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name [class]
     module.add_class('Name', parent=root_module['ns3::SimpleRefCount< ns3::ndn::Name, ns3::empty, ns3::DefaultDeleter<ns3::ndn::Name> >'])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::NameException [class]
+    module.add_class('NameException')
     ## ndn-name.h (module 'ndnSIM'): ns3::ndn::NameChecker [class]
     module.add_class('NameChecker', parent=root_module['ns3::AttributeChecker'])
     ## ndn-name.h (module 'ndnSIM'): ns3::ndn::NameValue [class]
     module.add_class('NameValue', parent=root_module['ns3::AttributeValue'])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::PrefixView [class]
+    module.add_class('PrefixView')
     ## ndn-net-device-face.h (module 'ndnSIM'): ns3::ndn::NetDeviceFace [class]
     module.add_class('NetDeviceFace', parent=root_module['ns3::ndn::Face'])
     ## ndn-pit.h (module 'ndnSIM'): ns3::ndn::Pit [class]
@@ -381,6 +387,9 @@ def register_types_ns3_ndn(module):
     module.add_container('std::vector< ns3::Ptr< ns3::ndn::Face > >', 'ns3::Ptr< ns3::ndn::Face >', container_type='vector')
     module.add_container('std::list< boost::reference_wrapper< std::string const > >', 'boost::reference_wrapper< std::basic_string< char, std::char_traits< char >, std::allocator< char > > const >', container_type='list')
     module.add_container('std::list< std::string >', 'std::string', container_type='list')
+    module.add_container('std::vector< ns3::Ptr< ns3::ndn::ContentObject const > >', 'ns3::Ptr< ns3::ndn::ContentObject const >', container_type='vector')
+    module.add_container('std::vector< ns3::Ptr< ns3::Packet const > >', 'ns3::Ptr< ns3::Packet const >', container_type='vector')
+    module.add_container('std::vector< ns3::ndn::Fib::Route >', 'ns3::ndn::Fib::Route', container_type='vector')
     typehandlers.add_type_alias('ns3::ndn::ContentObject', 'ns3::ndn::ContentObjectHeader')
     typehandlers.add_type_alias('ns3::ndn::ContentObject*', 'ns3::ndn::ContentObjectHeader*')
     typehandlers.add_type_alias('ns3::ndn::ContentObject&', 'ns3::ndn::ContentObjectHeader&')
@@ -440,6 +449,8 @@ def register_types_ns3_ndn_fib(module):
     module.add_enum('Status', ['NDN_FIB_GREEN', 'NDN_FIB_YELLOW', 'NDN_FIB_RED'], outer_class=root_module['ns3::ndn::fib::FaceMetric'])
     ## ndn-fib-entry.h (module 'ndnSIM'): ns3::ndn::fib::FaceMetricContainer [struct]
     module.add_class('FaceMetricContainer')
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::ndn::fib::HashLpm [class]
+    module.add_class('HashLpm', parent=root_module['ns3::ndn::Fib'])
     ## ndn-fib-entry.h (module 'ndnSIM'): ns3::ndn::fib::i_face [class]
     module.add_class('i_face')
     ## ndn-fib-entry.h (module 'ndnSIM'): ns3::ndn::fib::i_metric [class]
@@ -468,9 +479,10 @@ def register_types_ns3_ndn_pit(module):
     module.add_class('i_face')
     ## ndn-pit-entry.h (module 'ndnSIM'): ns3::ndn::pit::i_retx [class]
     module.add_class('i_retx')
-    module.add_container('std::set< ns3::ndn::pit::IncomingFace >', 'ns3::ndn::pit::IncomingFace', container_type='set')
-    module.add_container('std::set< ns3::ndn::pit::OutgoingFace >', 'ns3::ndn::pit::OutgoingFace', container_type='set')
+    module.add_container('ns3::ndn::pit::FaceContainer< ns3::ndn::pit::IncomingFace, 2 >', 'ns3::ndn::pit::IncomingFace', container_type='set')
+    module.add_container('ns3::ndn::pit::FaceContainer< ns3::ndn::pit::OutgoingFace, 2 >', 'ns3::ndn::pit::OutgoingFace', container_type='set')
     module.add_container('std::set< unsigned int >', 'unsigned int', container_type='set')
+    module.add_container('std::vector< ns3::Ptr< ns3::ndn::pit::Entry > >', 'ns3::Ptr< ns3::ndn::pit::Entry >', container_type='vector')
 
 def register_methods(root_module):
     register_Ns3Address_methods(root_module, root_module['ns3::Address'])
@@ -603,6 +615,7 @@ def register_methods(root_module):
     register_Ns3NdnFace_methods(root_module, root_module['ns3::ndn::Face'])
     register_Ns3NdnFaceContainer_methods(root_module, root_module['ns3::ndn::FaceContainer'])
     register_Ns3NdnFib_methods(root_module, root_module['ns3::ndn::Fib'])
+    register_Ns3NdnFibRoute_methods(root_module, root_module['ns3::ndn::Fib::Route'])
     register_Ns3NdnForwardingStrategy_methods(root_module, root_module['ns3::ndn::ForwardingStrategy'])
     register_Ns3NdnGlobalRoutingHelper_methods(root_module, root_module['ns3::ndn::GlobalRoutingHelper'])
     register_Ns3NdnHeaderHelper_methods(root_module, root_module['ns3::ndn::HeaderHelper'])
@@ -612,9 +625,11 @@ def register_methods(root_module):
     register_Ns3NdnLimits_methods(root_module, root_module['ns3::ndn::Limits'])
     register_Ns3NdnName_methods(root_module, root_module['ns3::ndn::Name'])
     register_Ns3NdnNameChecker_methods(root_module, root_module['ns3::ndn::NameChecker'])
+    register_Ns3NdnNameException_methods(root_module, root_module['ns3::ndn::NameException'])
     register_Ns3NdnNameValue_methods(root_module, root_module['ns3::ndn::NameValue'])
     register_Ns3NdnNetDeviceFace_methods(root_module, root_module['ns3::ndn::NetDeviceFace'])
     register_Ns3NdnPit_methods(root_module, root_module['ns3::ndn::Pit'])
+    register_Ns3NdnPrefixView_methods(root_module, root_module['ns3::ndn::PrefixView'])
     register_Ns3NdnRttEstimator_methods(root_module, root_module['ns3::ndn::RttEstimator'])
     register_Ns3NdnRttHistory_methods(root_module, root_module['ns3::ndn::RttHistory'])
     register_Ns3NdnStackHelper_methods(root_module, root_module['ns3::ndn::StackHelper'])
@@ -625,6 +640,7 @@ def register_methods(root_module):
     register_Ns3NdnFibEntryNoFaces_methods(root_module, root_module['ns3::ndn::fib::Entry::NoFaces'])
     register_Ns3NdnFibFaceMetric_methods(root_module, root_module['ns3::ndn::fib::FaceMetric'])
     register_Ns3NdnFibFaceMetricContainer_methods(root_module, root_module['ns3::ndn::fib::FaceMetricContainer'])
+    register_Ns3NdnFibHashLpm_methods(root_module, root_module['ns3::ndn::fib::HashLpm'])
     register_Ns3NdnFibI_face_methods(root_module, root_module['ns3::ndn::fib::i_face'])
     register_Ns3NdnFibI_metric_methods(root_module, root_module['ns3::ndn::fib::i_metric'])
     register_Ns3NdnFibI_nth_methods(root_module, root_module['ns3::ndn::fib::i_nth'])
@@ -4908,11 +4924,20 @@ def register_Ns3NdnContentStore_methods(root_module, cls):
                    'ns3::Ptr< ns3::ndn::cs::Entry >', 
                    [], 
                    is_pure_virtual=True, is_virtual=True)
+    ## ndn-content-store.h (module 'ndnSIM'): uint32_t ns3::ndn::ContentStore::BulkAdd(std::vector<ns3::Ptr<ns3::ndn::ContentObject const>, std::allocator<ns3::Ptr<ns3::ndn::ContentObject const> > > const & headers, std::vector<ns3::Ptr<const ns3::Packet>, std::allocator<ns3::Ptr<const ns3::Packet> > > const & packets) [member function]
+    cls.add_method('BulkAdd', 
+                   'uint32_t', 
+                   [param('std::vector< ns3::Ptr< ns3::ndn::ContentObject const > > const &', 'headers'), param('std::vector< ns3::Ptr< ns3::Packet const > > const &', 'packets')])
     ## ndn-content-store.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::cs::Entry> ns3::ndn::ContentStore::End() [member function]
     cls.add_method('End', 
                    'ns3::Ptr< ns3::ndn::cs::Entry >', 
                    [], 
                    is_pure_virtual=True, is_virtual=True)
+    ## ndn-content-store.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::cs::Entry> ns3::ndn::ContentStore::Find(ns3::ndn::PrefixView const & prefix) [member function]
+    cls.add_method('Find', 
+                   'ns3::Ptr< ns3::ndn::cs::Entry >', 
+                   [param('ns3::ndn::PrefixView const &', 'prefix')], 
+                   is_pure_virtual=True, is_virtual=True)
     ## ndn-content-store.h (module 'ndnSIM'): static ns3::Ptr<ns3::ndn::ContentStore> ns3::ndn::ContentStore::GetContentStore(ns3::Ptr<ns3::Object> node) [member function]
     cls.add_method('GetContentStore', 
                    'ns3::Ptr< ns3::ndn::ContentStore >', 
@@ -5069,6 +5094,11 @@ def register_Ns3NdnFib_methods(root_module, cls):
                    'ns3::Ptr< ns3::ndn::fib::Entry >', 
                    [param('ns3::Ptr< ns3::ndn::Name const > const &', 'prefix'), param('ns3::Ptr< ns3::ndn::Face >', 'face'), param('int32_t', 'metric')], 
                    is_pure_virtual=True, is_virtual=True)
+    ## ndn-fib.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::Fib::Add(ns3::ndn::PrefixView const & prefix, ns3::Ptr<ns3::ndn::Face> face, int32_t metric) [member function]
+    cls.add_method('Add', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::PrefixView const &', 'prefix'), param('ns3::Ptr< ns3::ndn::Face >', 'face'), param('int32_t', 'metric')], 
+                   is_pure_virtual=True, is_virtual=True)
     ## ndn-fib.h (module 'ndnSIM'): ns3::Ptr<const ns3::ndn::fib::Entry> ns3::ndn::Fib::Begin() const [member function]
     cls.add_method('Begin', 
                    'ns3::Ptr< ns3::ndn::fib::Entry const >', 
@@ -5079,6 +5109,11 @@ def register_Ns3NdnFib_methods(root_module, cls):
                    'ns3::Ptr< ns3::ndn::fib::Entry >', 
                    [], 
                    is_pure_virtual=True, is_virtual=True)
+    ## ndn-fib.h (module 'ndnSIM'): void ns3::ndn::Fib::BulkAdd(std::vector<ns3::ndn::Fib::Route, std::allocator<ns3::ndn::Fib::Route> > const & routes) [member function]
+    cls.add_method('BulkAdd', 
+                   'void', 
+                   [param('std::vector< ns3::ndn::Fib::Route > const &', 'routes')], 
+                   is_virtual=True)
     ## ndn-fib.h (module 'ndnSIM'): ns3::Ptr<const ns3::ndn::fib::Entry> ns3::ndn::Fib::End() const [member function]
     cls.add_method('End', 
                    'ns3::Ptr< ns3::ndn::fib::Entry const >', 
@@ -5094,6 +5129,11 @@ def register_Ns3NdnFib_methods(root_module, cls):
                    'ns3::Ptr< ns3::ndn::fib::Entry >', 
                    [param('ns3::ndn::Name const &', 'prefix')], 
                    is_pure_virtual=True, is_virtual=True)
+    ## ndn-fib.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::Fib::Find(ns3::ndn::PrefixView const & prefix) [member function]
+    cls.add_method('Find', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::PrefixView const &', 'prefix')], 
+                   is_pure_virtual=True, is_virtual=True)
     ## ndn-fib.h (module 'ndnSIM'): static ns3::Ptr<ns3::ndn::Fib> ns3::ndn::Fib::GetFib(ns3::Ptr<ns3::Object> node) [member function]
     cls.add_method('GetFib', 
                    'ns3::Ptr< ns3::ndn::Fib >', 
@@ -5146,6 +5186,19 @@ def register_Ns3NdnFib_methods(root_module, cls):
                    is_pure_virtual=True, is_virtual=True)
     return
 
+def register_Ns3NdnFibRoute_methods(root_module, cls):
+    ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib::Route::Route(ns3::ndn::Fib::Route const & arg0) [copy constructor]
+    cls.add_constructor([param('ns3::ndn::Fib::Route const &', 'arg0')])
+    ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib::Route::Route(ns3::Ptr<ns3::ndn::Name const> const & prefix, ns3::Ptr<ns3::ndn::Face> face, int32_t metric) [constructor]
+    cls.add_constructor([param('ns3::Ptr< ns3::ndn::Name const > const &', 'prefix'), param('ns3::Ptr< ns3::ndn::Face >', 'face'), param('int32_t', 'metric')])
+    ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib::Route::m_face [variable]
+    cls.add_instance_attribute('m_face', 'ns3::Ptr< ns3::ndn::Face >', is_const=False)
+    ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib::Route::m_metric [variable]
+    cls.add_instance_attribute('m_metric', 'int32_t', is_const=False)
+    ## ndn-fib.h (module 'ndnSIM'): ns3::ndn::Fib::Route::m_prefix [variable]
+    cls.add_instance_attribute('m_prefix', 'ns3::Ptr< ns3::ndn::Name const >', is_const=False)
+    return
+
 def register_Ns3NdnForwardingStrategy_methods(root_module, cls):
     ## ndn-forwarding-strategy.h (module 'ndnSIM'): ns3::ndn::ForwardingStrategy::ForwardingStrategy(ns3::ndn::ForwardingStrategy const & arg0) [copy constructor]
     cls.add_constructor([param('ns3::ndn::ForwardingStrategy const &', 'arg0')])
@@ -5221,6 +5274,11 @@ def register_Ns3NdnForwardingStrategy_methods(root_module, cls):
                    'void', 
                    [param('ns3::Ptr< ns3::ndn::Face >', 'inFace'), param('ns3::Ptr< ns3::ndn::Interest const >', 'header'), param('ns3::Ptr< ns3::Packet const >', 'origPacket'), param('ns3::Ptr< ns3::ndn::pit::Entry >', 'pitEntry')], 
                    visibility='protected', is_virtual=True)
+    ## ndn-forwarding-strategy.h (module 'ndnSIM'): void ns3::ndn::ForwardingStrategy::DidReceiveDeadNonceInterest(ns3::Ptr<ns3::ndn::Face> inFace, ns3::Ptr<ns3::ndn::Interest const> header, ns3::Ptr<const ns3::Packet> origPacket) [member function]
+    cls.add_method('DidReceiveDeadNonceInterest', 
+                   'void', 
+                   [param('ns3::Ptr< ns3::ndn::Face >', 'inFace'), param('ns3::Ptr< ns3::ndn::Interest const >', 'header'), param('ns3::Ptr< ns3::Packet const >', 'origPacket')], 
+                   visibility='protected', is_virtual=True)
     ## ndn-forwarding-strategy.h (module 'ndnSIM'): void ns3::ndn::ForwardingStrategy::DidReceiveDuplicateInterest(ns3::Ptr<ns3::ndn::Face> inFace, ns3::Ptr<ns3::ndn::Interest const> header, ns3::Ptr<const ns3::Packet> origPacket, ns3::Ptr<ns3::ndn::pit::Entry> pitEntry) [member function]
     cls.add_method('DidReceiveDuplicateInterest', 
                    'void', 
@@ -5627,13 +5685,19 @@ def register_Ns3NdnName_methods(root_module, cls):
     cls.add_constructor([param('std::string const &', 'prefix')])
     ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name::Name(char const * prefix) [constructor]
     cls.add_constructor([param('char const *', 'prefix')])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name::Name(char const * prefix, size_t length) [constructor]
+    cls.add_constructor([param('char const *', 'prefix'), param('size_t', 'length')])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name & ns3::ndn::Name::AppendSeqNum(uint32_t seqNo) [member function]
+    cls.add_method('AppendSeqNum', 
+                   'ns3::ndn::Name &', 
+                   [param('uint32_t', 'seqNo')])
     ## ndn-name.h (module 'ndnSIM'): uint32_t ns3::ndn::Name::Deserialize(ns3::Buffer::Iterator start) [member function]
     cls.add_method('Deserialize', 
                    'uint32_t', 
                    [param('ns3::Buffer::Iterator', 'start')])
-    ## ndn-name.h (module 'ndnSIM'): std::list<std::string, std::allocator<std::string> > const & ns3::ndn::Name::GetComponents() const [member function]
+    ## ndn-name.h (module 'ndnSIM'): std::list<std::string, std::allocator<std::string> > ns3::ndn::Name::GetComponents() const [member function]
     cls.add_method('GetComponents', 
-                   'std::list< std::string > const &', 
+                   'std::list< std::string >', 
                    [], 
                    is_const=True)
     ## ndn-name.h (module 'ndnSIM'): std::string ns3::ndn::Name::GetLastComponent() const [member function]
@@ -5641,16 +5705,31 @@ def register_Ns3NdnName_methods(root_module, cls):
                    'std::string', 
                    [], 
                    is_const=True)
+    ## ndn-name.h (module 'ndnSIM'): uint32_t ns3::ndn::Name::GetLastSeqNum() const [member function]
+    cls.add_method('GetLastSeqNum', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## ndn-name.h (module 'ndnSIM'): std::size_t ns3::ndn::Name::GetPrefixHash(size_t length) const [member function]
+    cls.add_method('GetPrefixHash', 
+                   'std::size_t', 
+                   [param('size_t', 'length')], 
+                   is_const=True)
     ## ndn-name.h (module 'ndnSIM'): size_t ns3::ndn::Name::GetSerializedSize() const [member function]
     cls.add_method('GetSerializedSize', 
                    'size_t', 
                    [], 
                    is_const=True)
-    ## ndn-name.h (module 'ndnSIM'): std::list<boost::reference_wrapper<const std::basic_string<char, std::char_traits<char>, std::allocator<char> > >,std::allocator<boost::reference_wrapper<const std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > > ns3::ndn::Name::GetSubComponents(size_t num) const [member function]
+    ## ndn-name.h (module 'ndnSIM'): std::list<std::string, std::allocator<std::string> > ns3::ndn::Name::GetSubComponents(size_t num) const [member function]
     cls.add_method('GetSubComponents', 
-                   'std::list< boost::reference_wrapper< std::string const > >', 
+                   'std::list< std::string >', 
                    [param('size_t', 'num')], 
                    is_const=True)
+    ## ndn-name.h (module 'ndnSIM'): bool ns3::ndn::Name::HasSeqNum() const [member function]
+    cls.add_method('HasSeqNum', 
+                   'bool', 
+                   [], 
+                   is_const=True)
     ## ndn-name.h (module 'ndnSIM'): void ns3::ndn::Name::Print(std::ostream & os) const [member function]
     cls.add_method('Print', 
                    'void', 
@@ -5661,29 +5740,11 @@ def register_Ns3NdnName_methods(root_module, cls):
                    'uint32_t', 
                    [param('ns3::Buffer::Iterator', 'start')], 
                    is_const=True)
-    ## ndn-name.h (module 'ndnSIM'): std::_List_iterator<std::string> ns3::ndn::Name::begin() [member function]
-    cls.add_method('begin', 
-                   'std::_List_iterator< std::string >', 
-                   [])
-    ## ndn-name.h (module 'ndnSIM'): std::_List_const_iterator<std::string> ns3::ndn::Name::begin() const [member function]
-    cls.add_method('begin', 
-                   'std::_List_const_iterator< std::string >', 
-                   [], 
-                   is_const=True)
     ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name ns3::ndn::Name::cut(size_t minusComponents) const [member function]
     cls.add_method('cut', 
                    'ns3::ndn::Name', 
                    [param('size_t', 'minusComponents')], 
                    is_const=True)
-    ## ndn-name.h (module 'ndnSIM'): std::_List_iterator<std::string> ns3::ndn::Name::end() [member function]
-    cls.add_method('end', 
-                   'std::_List_iterator< std::string >', 
-                   [])
-    ## ndn-name.h (module 'ndnSIM'): std::_List_const_iterator<std::string> ns3::ndn::Name::end() const [member function]
-    cls.add_method('end', 
-                   'std::_List_const_iterator< std::string >', 
-                   [], 
-                   is_const=True)
     ## ndn-name.h (module 'ndnSIM'): size_t ns3::ndn::Name::size() const [member function]
     cls.add_method('size', 
                    'size_t', 
@@ -5698,6 +5759,13 @@ def register_Ns3NdnNameChecker_methods(root_module, cls):
     cls.add_constructor([param('ns3::ndn::NameChecker const &', 'arg0')])
     return
 
+def register_Ns3NdnNameException_methods(root_module, cls):
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::NameException::NameException() [constructor]
+    cls.add_constructor([])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::NameException::NameException(ns3::ndn::NameException const & arg0) [copy constructor]
+    cls.add_constructor([param('ns3::ndn::NameException const &', 'arg0')])
+    return
+
 def register_Ns3NdnNameValue_methods(root_module, cls):
     ## ndn-name.h (module 'ndnSIM'): ns3::ndn::NameValue::NameValue() [constructor]
     cls.add_constructor([])
@@ -5787,6 +5855,16 @@ def register_Ns3NdnPit_methods(root_module, cls):
                    'ns3::Ptr< ns3::ndn::pit::Entry >', 
                    [param('ns3::ndn::Name const &', 'prefix')], 
                    is_pure_virtual=True, is_virtual=True)
+    ## ndn-pit.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::pit::Entry> ns3::ndn::Pit::Find(ns3::ndn::PrefixView const & prefix) [member function]
+    cls.add_method('Find', 
+                   'ns3::Ptr< ns3::ndn::pit::Entry >', 
+                   [param('ns3::ndn::PrefixView const &', 'prefix')], 
+                   is_pure_virtual=True, is_virtual=True)
+    ## ndn-pit.h (module 'ndnSIM'): std::vector<ns3::Ptr<ns3::ndn::pit::Entry>, std::allocator<ns3::Ptr<ns3::ndn::pit::Entry> > > ns3::ndn::Pit::FindAllMatches(ns3::ndn::ContentObject const & header) [member function]
+    cls.add_method('FindAllMatches', 
+                   'std::vector< ns3::Ptr< ns3::ndn::pit::Entry > >', 
+                   [param('ns3::ndn::ContentObject const &', 'header')], 
+                   is_pure_virtual=True, is_virtual=True)
     ## ndn-pit.h (module 'ndnSIM'): ns3::Time const & ns3::ndn::Pit::GetMaxPitEntryLifetime() const [member function]
     cls.add_method('GetMaxPitEntryLifetime', 
                    'ns3::Time const &', 
@@ -6013,6 +6091,16 @@ def register_Ns3NdnStackHelper_methods(root_module, cls):
                    'void', 
                    [param('std::string const &', 'nodeName'), param('std::string const &', 'prefix'), param('std::string const &', 'otherNodeName'), param('int32_t', 'metric')], 
                    is_static=True)
+    ## ndn-stack-helper.h (module 'ndnSIM'): static uint32_t ns3::ndn::StackHelper::AddRoutesFromFile(ns3::Ptr<ns3::Node> node, std::string const & filename) [member function]
+    cls.add_method('AddRoutesFromFile', 
+                   'uint32_t', 
+                   [param('ns3::Ptr< ns3::Node >', 'node'), param('std::string const &', 'filename')], 
+                   is_static=True)
+    ## ndn-stack-helper.h (module 'ndnSIM'): static uint32_t ns3::ndn::StackHelper::AddRoutesFromFile(std::string const & nodeName, std::string const & filename) [member function]
+    cls.add_method('AddRoutesFromFile', 
+                   'uint32_t', 
+                   [param('std::string const &', 'nodeName'), param('std::string const &', 'filename')], 
+                   is_static=True)
     ## ndn-stack-helper.h (module 'ndnSIM'): void ns3::ndn::StackHelper::SetDefaultRoutes(bool needSet) [member function]
     cls.add_method('SetDefaultRoutes', 
                    'void', 
@@ -6199,6 +6287,111 @@ def register_Ns3NdnFibFaceMetricContainer_methods(root_module, cls):
     cls.add_constructor([param('ns3::ndn::fib::FaceMetricContainer const &', 'arg0')])
     return
 
+def register_Ns3NdnFibHashLpm_methods(root_module, cls):
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::ndn::fib::HashLpm::HashLpm() [constructor]
+    cls.add_constructor([])
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Add(ns3::ndn::Name const & prefix, ns3::Ptr<ns3::ndn::Face> face, int32_t metric) [member function]
+    cls.add_method('Add', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::Name const &', 'prefix'), param('ns3::Ptr< ns3::ndn::Face >', 'face'), param('int32_t', 'metric')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Add(ns3::Ptr<ns3::ndn::Name const> const & prefix, ns3::Ptr<ns3::ndn::Face> face, int32_t metric) [member function]
+    cls.add_method('Add', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::Ptr< ns3::ndn::Name const > const &', 'prefix'), param('ns3::Ptr< ns3::ndn::Face >', 'face'), param('int32_t', 'metric')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Add(ns3::ndn::PrefixView const & prefix, ns3::Ptr<ns3::ndn::Face> face, int32_t metric) [member function]
+    cls.add_method('Add', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::PrefixView const &', 'prefix'), param('ns3::Ptr< ns3::ndn::Face >', 'face'), param('int32_t', 'metric')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<const ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Begin() const [member function]
+    cls.add_method('Begin', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry const >', 
+                   [], 
+                   is_const=True, is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Begin() [member function]
+    cls.add_method('Begin', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): void ns3::ndn::fib::HashLpm::BulkAdd(std::vector<ns3::ndn::Fib::Route, std::allocator<ns3::ndn::Fib::Route> > const & routes) [member function]
+    cls.add_method('BulkAdd', 
+                   'void', 
+                   [param('std::vector< ns3::ndn::Fib::Route > const &', 'routes')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<const ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::End() const [member function]
+    cls.add_method('End', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry const >', 
+                   [], 
+                   is_const=True, is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::End() [member function]
+    cls.add_method('End', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Find(ns3::ndn::Name const & prefix) [member function]
+    cls.add_method('Find', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::Name const &', 'prefix')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Find(ns3::ndn::PrefixView const & prefix) [member function]
+    cls.add_method('Find', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::PrefixView const &', 'prefix')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): uint32_t ns3::ndn::fib::HashLpm::GetSize() const [member function]
+    cls.add_method('GetSize', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True, is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): static ns3::TypeId ns3::ndn::fib::HashLpm::GetTypeId() [member function]
+    cls.add_method('GetTypeId', 
+                   'ns3::TypeId', 
+                   [], 
+                   is_static=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): void ns3::ndn::fib::HashLpm::InvalidateAll() [member function]
+    cls.add_method('InvalidateAll', 
+                   'void', 
+                   [], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::LongestPrefixMatch(ns3::ndn::Interest const & interest) [member function]
+    cls.add_method('LongestPrefixMatch', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::ndn::Interest const &', 'interest')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<const ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Next(ns3::Ptr<const ns3::ndn::fib::Entry> item) const [member function]
+    cls.add_method('Next', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry const >', 
+                   [param('ns3::Ptr< ns3::ndn::fib::Entry const >', 'item')], 
+                   is_const=True, is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::fib::Entry> ns3::ndn::fib::HashLpm::Next(ns3::Ptr<ns3::ndn::fib::Entry> item) [member function]
+    cls.add_method('Next', 
+                   'ns3::Ptr< ns3::ndn::fib::Entry >', 
+                   [param('ns3::Ptr< ns3::ndn::fib::Entry >', 'item')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): void ns3::ndn::fib::HashLpm::Print(std::ostream & os) const [member function]
+    cls.add_method('Print', 
+                   'void', 
+                   [param('std::ostream &', 'os')], 
+                   is_const=True, is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): void ns3::ndn::fib::HashLpm::Remove(ns3::Ptr<ns3::ndn::Name const> const & prefix) [member function]
+    cls.add_method('Remove', 
+                   'void', 
+                   [param('ns3::Ptr< ns3::ndn::Name const > const &', 'prefix')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): void ns3::ndn::fib::HashLpm::RemoveFromAll(ns3::Ptr<ns3::ndn::Face> face) [member function]
+    cls.add_method('RemoveFromAll', 
+                   'void', 
+                   [param('ns3::Ptr< ns3::ndn::Face >', 'face')], 
+                   is_virtual=True)
+    ## ndn-fib-hash-lpm.h (module 'ndnSIM'): void ns3::ndn::fib::HashLpm::DoDispose() [member function]
+    cls.add_method('DoDispose', 
+                   'void', 
+                   [], 
+                   visibility='protected', is_virtual=True)
+    return
+
 def register_Ns3NdnFibI_face_methods(root_module, cls):
     ## ndn-fib-entry.h (module 'ndnSIM'): ns3::ndn::fib::i_face::i_face() [constructor]
     cls.add_constructor([])
@@ -6227,6 +6420,31 @@ def register_Ns3NdnFwTag_methods(root_module, cls):
     cls.add_constructor([param('ns3::ndn::fw::Tag const &', 'arg0')])
     return
 
+def register_Ns3NdnPrefixView_methods(root_module, cls):
+    cls.add_output_stream_operator()
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::PrefixView::PrefixView(ns3::ndn::PrefixView const & arg0) [copy constructor]
+    cls.add_constructor([param('ns3::ndn::PrefixView const &', 'arg0')])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::PrefixView::PrefixView(ns3::ndn::Name const & name) [constructor]
+    cls.add_constructor([param('ns3::ndn::Name const &', 'name')])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::PrefixView::PrefixView(ns3::ndn::Name const & name, size_t length) [constructor]
+    cls.add_constructor([param('ns3::ndn::Name const &', 'name'), param('size_t', 'length')])
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name const & ns3::ndn::PrefixView::GetName() const [member function]
+    cls.add_method('GetName', 
+                   'ns3::ndn::Name const &', 
+                   [], 
+                   is_const=True)
+    ## ndn-name.h (module 'ndnSIM'): ns3::ndn::Name ns3::ndn::PrefixView::ToName() const [member function]
+    cls.add_method('ToName', 
+                   'ns3::ndn::Name', 
+                   [], 
+                   is_const=True)
+    ## ndn-name.h (module 'ndnSIM'): size_t ns3::ndn::PrefixView::size() const [member function]
+    cls.add_method('size', 
+                   'size_t', 
+                   [], 
+                   is_const=True)
+    return
+
 def register_Ns3NdnPitEntry_methods(root_module, cls):
     cls.add_output_stream_operator()
     ## ndn-pit-entry.h (module 'ndnSIM'): ns3::ndn::pit::Entry::Entry(ns3::ndn::pit::Entry const & arg0) [copy constructor]
@@ -6237,14 +6455,14 @@ def register_Ns3NdnPitEntry_methods(root_module, cls):
     cls.add_method('AddFwTag', 
                    'void', 
                    [param('boost::shared_ptr< ns3::ndn::fw::Tag >', 'tag')])
-    ## ndn-pit-entry.h (module 'ndnSIM'): std::_Rb_tree_const_iterator<ns3::ndn::pit::IncomingFace> ns3::ndn::pit::Entry::AddIncoming(ns3::Ptr<ns3::ndn::Face> face) [member function]
+    ## ndn-pit-entry.h (module 'ndnSIM'): ns3::ndn::pit::IncomingFace const * ns3::ndn::pit::Entry::AddIncoming(ns3::Ptr<ns3::ndn::Face> face) [member function]
     cls.add_method('AddIncoming', 
-                   'std::_Rb_tree_const_iterator< ns3::ndn::pit::IncomingFace >', 
+                   retval('ns3::ndn::pit::IncomingFace const *', caller_owns_return=False), 
                    [param('ns3::Ptr< ns3::ndn::Face >', 'face')], 
                    is_virtual=True)
-    ## ndn-pit-entry.h (module 'ndnSIM'): std::_Rb_tree_const_iterator<ns3::ndn::pit::OutgoingFace> ns3::ndn::pit::Entry::AddOutgoing(ns3::Ptr<ns3::ndn::Face> face) [member function]
+    ## ndn-pit-entry.h (module 'ndnSIM'): ns3::ndn::pit::OutgoingFace const * ns3::ndn::pit::Entry::AddOutgoing(ns3::Ptr<ns3::ndn::Face> face) [member function]
     cls.add_method('AddOutgoing', 
-                   'std::_Rb_tree_const_iterator< ns3::ndn::pit::OutgoingFace >', 
+                   retval('ns3::ndn::pit::OutgoingFace const *', caller_owns_return=False), 
                    [param('ns3::Ptr< ns3::ndn::Face >', 'face')], 
                    is_virtual=True)
     ## ndn-pit-entry.h (module 'ndnSIM'): void ns3::ndn::pit::Entry::AddSeenNonce(uint32_t nonce) [member function]
@@ -6281,9 +6499,9 @@ def register_Ns3NdnPitEntry_methods(root_module, cls):
     cls.add_method('GetFibEntry', 
                    'ns3::Ptr< ns3::ndn::fib::Entry >', 
                    [])
-    ## ndn-pit-entry.h (module 'ndnSIM'): std::set<ns3::ndn::pit::IncomingFace, std::less<ns3::ndn::pit::IncomingFace>, std::allocator<ns3::ndn::pit::IncomingFace> > const & ns3::ndn::pit::Entry::GetIncoming() const [member function]
+    ## ndn-pit-entry.h (module 'ndnSIM'): ns3::ndn::pit::FaceContainer<ns3::ndn::pit::IncomingFace, 2u> const & ns3::ndn::pit::Entry::GetIncoming() const [member function]
     cls.add_method('GetIncoming', 
-                   'std::set< ns3::ndn::pit::IncomingFace > const &', 
+                   'ns3::ndn::pit::FaceContainer< ns3::ndn::pit::IncomingFace, 2 > const &', 
                    [], 
                    is_const=True)
     ## ndn-pit-entry.h (module 'ndnSIM'): ns3::Ptr<ns3::ndn::Interest const> ns3::ndn::pit::Entry::GetInterest() const [member function]
@@ -6291,14 +6509,34 @@ def register_Ns3NdnPitEntry_methods(root_module, cls):
                    'ns3::Ptr< ns3::ndn::Interest const >', 
                    [], 
                    is_const=True)
+    ## ndn-pit-entry.h (module 'ndnSIM'): ns3::Time const & ns3::ndn::pit::Entry::GetInterestLifetime() const [member function]
+    cls.add_method('GetInterestLifetime', 
+                   'ns3::Time const &', 
+                   [], 
+                   is_const=True)
+    ## ndn-pit-entry.h (module 'ndnSIM'): uint32_t ns3::ndn::pit::Entry::GetInterestSize() const [member function]
+    cls.add_method('GetInterestSize', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
     ## ndn-pit-entry.h (module 'ndnSIM'): uint32_t ns3::ndn::pit::Entry::GetMaxRetxCount() const [member function]
     cls.add_method('GetMaxRetxCount', 
                    'uint32_t', 
                    [], 
                    is_const=True)
-    ## ndn-pit-entry.h (module 'ndnSIM'): std::set<ns3::ndn::pit::OutgoingFace, std::less<ns3::ndn::pit::OutgoingFace>, std::allocator<ns3::ndn::pit::OutgoingFace> > const & ns3::ndn::pit::Entry::GetOutgoing() const [member function]
+    ## ndn-pit-entry.h (module 'ndnSIM'): uint8_t ns3::ndn::pit::Entry::GetNack() const [member function]
+    cls.add_method('GetNack', 
+                   'uint8_t', 
+                   [], 
+                   is_const=True)
+    ## ndn-pit-entry.h (module 'ndnSIM'): uint32_t ns3::ndn::pit::Entry::GetNonce() const [member function]
+    cls.add_method('GetNonce', 
+                   'uint32_t', 
+                   [], 
+                   is_const=True)
+    ## ndn-pit-entry.h (module 'ndnSIM'): ns3::ndn::pit::FaceContainer<ns3::ndn::pit::OutgoingFace, 2u> const & ns3::ndn::pit::Entry::GetOutgoing() const [member function]
     cls.add_method('GetOutgoing', 
-                   'std::set< ns3::ndn::pit::OutgoingFace > const &', 
+                   'ns3::ndn::pit::FaceContainer< ns3::ndn::pit::OutgoingFace, 2 > const &', 
                    [], 
                    is_const=True)
     ## ndn-pit-entry.h (module 'ndnSIM'): uint32_t ns3::ndn::pit::Entry::GetOutgoingCount() const [member function]
@@ -6311,11 +6549,21 @@ def register_Ns3NdnPitEntry_methods(root_module, cls):
                    'ns3::ndn::Name const &', 
                    [], 
                    is_const=True)
+    ## ndn-pit-entry.h (module 'ndnSIM'): int8_t ns3::ndn::pit::Entry::GetScope() const [member function]
+    cls.add_method('GetScope', 
+                   'int8_t', 
+                   [], 
+                   is_const=True)
     ## ndn-pit-entry.h (module 'ndnSIM'): void ns3::ndn::pit::Entry::IncreaseAllowedRetxCount() [member function]
     cls.add_method('IncreaseAllowedRetxCount', 
                    'void', 
                    [], 
                    is_virtual=True)
+    ## ndn-pit-entry.h (module 'ndnSIM'): bool ns3::ndn::pit::Entry::IsLean() const [member function]
+    cls.add_method('IsLean', 
+                   'bool', 
+                   [], 
+                   is_const=True)
     ## ndn-pit-entry.h (module 'ndnSIM'): bool ns3::ndn::pit::Entry::IsNonceSeen(uint32_t nonce) const [member function]
     cls.add_method('IsNonceSeen', 
                    'bool', 
@@ -81,16 +81,17 @@ CustomStrategy::DidSendOutInterest (Ptr<Face> inFace, Ptr<Face> outFace,
                                     Ptr<pit::Entry> pitEntry)
 {
   m_counter ++;
+  pitEntry->GetOrCreateFwTag<ForwardedInterestsTag> ().m_count ++;
 }
 
 void
 CustomStrategy::WillEraseTimedOutPendingInterest (Ptr<pit::Entry> pitEntry)
 {
-  for (pit::Entry::out_container::iterator face = pitEntry->GetOutgoing ().begin ();
-       face != pitEntry->GetOutgoing ().end ();
-       face ++)
+  ForwardedInterestsTag *tag = pitEntry->PeekFwTag<ForwardedInterestsTag> ();
+  if (tag != 0)
     {
-      m_counter --;
+      m_counter -= tag->m_count;
+      pitEntry->RemoveFwTag<ForwardedInterestsTag> ();
     }
 
   BaseStrategy::WillEraseTimedOutPendingInterest (pitEntry);
@@ -101,11 +102,11 @@ void
 CustomStrategy::WillSatisfyPendingInterest (Ptr<Face> inFace,
                                             Ptr<pit::Entry> pitEntry)
 {
-  for (pit::Entry::out_container::iterator face = pitEntry->GetOutgoing ().begin ();
-       face != pitEntry->GetOutgoing ().end ();
-       face ++)
+  ForwardedInterestsTag *tag = pitEntry->PeekFwTag<ForwardedInterestsTag> ();
+  if (tag != 0)
     {
-      m_counter --;
+      m_counter -= tag->m_count;
+      pitEntry->RemoveFwTag<ForwardedInterestsTag> ();
     }
 
   BaseStrategy::WillSatisfyPendingInterest (inFace, pitEntry);
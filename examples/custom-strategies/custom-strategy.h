@@ -8,6 +8,7 @@
 #include "ns3/log.h"
 #include "ns3/ndn-forwarding-strategy.h"
 #include "ns3/ndn-l3-protocol.h"
+#include "ns3/ndn-fw-tag.h"
                 
 namespace ns3 {
 namespace ndn {
@@ -56,6 +57,15 @@ protected:
 
 private:
   uint32_t m_counter;
+
+  /**
+   * @brief PIT entry tag, counting Interests forwarded for the entry
+   */
+  struct ForwardedInterestsTag : public Tag
+  {
+    ForwardedInterestsTag () : m_count (0) { }
+    uint32_t m_count;
+  };
 };
         
         
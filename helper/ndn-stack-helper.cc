@@ -55,6 +55,9 @@
 
 #include <limits>
 #include <map>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -360,9 +363,85 @@ StackHelper::AddRoute (Ptr<Node> node, const std::string &prefix, Ptr<Face> face
 
   Ptr<Fib>  fib  = node->GetObject<Fib> ();
 
-  NameValue prefixValue;
-  prefixValue.DeserializeFromString (prefix, MakeNameChecker ());
-  fib->Add (prefixValue.Get (), face, metric);
+  fib->Add (Create<Name> (prefix), face, metric);
+}
+
+uint32_t
+StackHelper::AddRoutesFromFile (Ptr<Node> node, const std::string &filename)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol> ();
+  NS_ASSERT_MSG (ndn != 0, "Ndn stack should be installed on the node");
+
+  Ptr<Fib> fib = node->GetObject<Fib> ();
+
+  std::ifstream file (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!file.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open file [" << filename << "] with forwarding entries");
+    }
+
+  std::vector<char> content ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char> ());
+  content.push_back ('\0'); // guard for strtol
+
+  std::vector<Fib::Route> routes;
+  uint32_t lineNumber = 0;
+  const char *position = &content[0];
+  const char *end = &content[0] + content.size () - 1;
+  while (position < end)
+    {
+      lineNumber ++;
+      const char *lineEnd = std::find (position, end, '\n');
+
+      // skip leading whitespace
+      while (position < lineEnd && (*position == ' ' || *position == '\t' || *position == '\r'))
+        position ++;
+
+      if (position == lineEnd || *position == '#')
+        {
+          position = lineEnd + 1;
+          continue;
+        }
+
+      const char *prefixEnd = position;
+      while (prefixEnd < lineEnd && *prefixEnd != ' ' && *prefixEnd != '\t')
+        prefixEnd ++;
+
+      char *fieldEnd = 0;
+      unsigned long faceId = std::strtoul (prefixEnd, &fieldEnd, 10);
+      if (fieldEnd == prefixEnd || fieldEnd > lineEnd)
+        {
+          NS_FATAL_ERROR ("Invalid face index in [" << filename << "], line " << lineNumber);
+        }
+
+      const char *metricStart = fieldEnd;
+      long metric = std::strtol (metricStart, &fieldEnd, 10);
+      if (fieldEnd == metricStart || fieldEnd > lineEnd)
+        {
+          NS_FATAL_ERROR ("Invalid routing metric in [" << filename << "], line " << lineNumber);
+        }
+
+      Ptr<Face> face = ndn->GetFace (faceId);
+      NS_ASSERT_MSG (face != 0, "Face with ID [" << faceId << "] does not exist on node [" << node->GetId () << "]");
+
+      routes.push_back (Fib::Route (Create<Name> (position, static_cast<size_t> (prefixEnd - position)),
+                                    face, static_cast<int32_t> (metric)));
+
+      position = lineEnd + 1;
+    }
+
+  fib->BulkAdd (routes);
+
+  NS_LOG_INFO ("[" << node->GetId () << "]$ loaded " << routes.size () << " routes from " << filename);
+  return routes.size ();
+}
+
+uint32_t
+StackHelper::AddRoutesFromFile (const std::string &nodeName, const std::string &filename)
+{
+  Ptr<Node> node = Names::Find<Node> (nodeName);
+  NS_ASSERT_MSG (node != 0, "Node [" << nodeName << "] does not exist");
+
+  return AddRoutesFromFile (node, filename);
 }
 
 void
@@ -263,6 +263,34 @@ public:
   static void
   AddRoute (const std::string &nodeName, const std::string &prefix, const std::string &otherNodeName, int32_t metric);
 
+  /**
+   * @brief Load forwarding entries from the file into the node's FIB
+   *
+   * Each line of the file should contain a routing prefix, face index, and routing metric,
+   * separated by whitespace, e.g.:
+   *
+   *     /prefix/sub 1 10
+   *
+   * Empty lines and lines starting with # are ignored.  The whole file is read in one go and parsed
+   * in place, and all routes are added with a single Fib::BulkAdd call
+   *
+   * \param node     Node
+   * \param filename Name of the file with forwarding entries
+   * \returns number of loaded forwarding entries
+   */
+  static uint32_t
+  AddRoutesFromFile (Ptr<Node> node, const std::string &filename);
+
+  /**
+   * @brief Load forwarding entries from the file into the node's FIB
+   *
+   * \param nodeName Node name (refer to ns3::Names)
+   * \param filename Name of the file with forwarding entries (see AddRoutesFromFile (Ptr<Node>, const std::string&))
+   * \returns number of loaded forwarding entries
+   */
+  static uint32_t
+  AddRoutesFromFile (const std::string &nodeName, const std::string &filename);
+
   /**
    * \brief Set flag indicating necessity to install default routes in FIB
    */
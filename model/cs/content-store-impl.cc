@@ -24,6 +24,9 @@
 #include "../../utils/trie/lru-policy.h"
 #include "../../utils/trie/fifo-policy.h"
 #include "../../utils/trie/lfu-policy.h"
+#include "../../utils/trie/lfu-bucket-policy.h"
+#include "../../utils/trie/arc-policy.h"
+#include "../../utils/trie/tinylfu-policy.h"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
   static struct X ## type ## templ ## RegistrationClass \
@@ -34,6 +37,15 @@
     }                                                   \
   } x_ ## type ## templ ## RegistrationVariable
 
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(type, templ, engine)  \
+  static struct X ## type ## templ ## engine ## RegistrationClass     \
+  {                                                                   \
+    X ## type ## templ ## engine ## RegistrationClass () {            \
+      ns3::TypeId tid = type<templ, engine>::GetTypeId ();            \
+      tid.GetParent ();                                               \
+    }                                                                 \
+  } x_ ## type ## templ ## engine ## RegistrationVariable
+
 namespace ns3 {
 namespace ndn {
 
@@ -62,11 +74,58 @@ template class ContentStoreImpl<fifo_policy_traits>;
  **/
 template class ContentStoreImpl<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with LFU cache replacement policy, based on frequency buckets (O(1) hit, insert, and eviction)
+ **/
+template class ContentStoreImpl<lfu_bucket_policy_traits>;
+
+/**
+ * @brief ContentStore with Adaptive Replacement Cache (ARC) policy
+ **/
+template class ContentStoreImpl<arc_policy_traits>;
+
+typedef tinylfu_admission_traits<lru_policy_traits> tinylfu_lru_policy_traits;
+typedef tinylfu_admission_traits<random_policy_traits> tinylfu_random_policy_traits;
+typedef tinylfu_admission_traits<fifo_policy_traits> tinylfu_fifo_policy_traits;
+typedef tinylfu_admission_traits<lfu_policy_traits> tinylfu_lfu_policy_traits;
+
+/**
+ * @brief ContentStores with TinyLFU admission filter in front of cache replacement policy
+ **/
+template class ContentStoreImpl<tinylfu_lru_policy_traits>;
+template class ContentStoreImpl<tinylfu_random_policy_traits>;
+template class ContentStoreImpl<tinylfu_fifo_policy_traits>;
+template class ContentStoreImpl<tinylfu_lfu_policy_traits>;
+
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, fifo_policy_traits);
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, lfu_bucket_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, arc_policy_traits);
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_lru_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_random_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_fifo_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, tinylfu_lfu_policy_traits);
+
+/**
+ * @brief ContentStores using path-compressed trie (radix_trie), better suited for long names
+ **/
+template class ContentStoreImpl<lru_policy_traits, radix_trie>;
+template class ContentStoreImpl<random_policy_traits, radix_trie>;
+template class ContentStoreImpl<fifo_policy_traits, radix_trie>;
+template class ContentStoreImpl<lfu_policy_traits, radix_trie>;
+template class ContentStoreImpl<lfu_bucket_policy_traits, radix_trie>;
+template class ContentStoreImpl<arc_policy_traits, radix_trie>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(ContentStoreImpl, lru_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(ContentStoreImpl, random_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(ContentStoreImpl, fifo_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(ContentStoreImpl, lfu_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(ContentStoreImpl, lfu_bucket_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(ContentStoreImpl, arc_policy_traits, radix_trie);
 
 #ifdef DOXYGEN
 // /**
@@ -88,6 +147,67 @@ class Random : public ContentStoreImpl<random_policy_traits> { };
  * \brief Content Store implementing Least Frequently Used cache replacement policy
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> { };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy
+ *        with constant time cache hits, inserts, and evictions (ties are broken in LRU order)
+ */
+class LfuBucket : public ContentStoreImpl<lfu_bucket_policy_traits> { };
+
+/**
+ * \brief Content Store implementing Adaptive Replacement Cache (ARC) policy
+ */
+class Arc : public ContentStoreImpl<arc_policy_traits> { };
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy with TinyLFU admission filter
+ */
+class TinyLfu::Lru : public ContentStoreImpl<tinylfu_lru_policy_traits> { };
+
+/**
+ * \brief Content Store implementing Random cache replacement policy with TinyLFU admission filter
+ */
+class TinyLfu::Random : public ContentStoreImpl<tinylfu_random_policy_traits> { };
+
+/**
+ * \brief Content Store implementing FIFO cache replacement policy with TinyLFU admission filter
+ */
+class TinyLfu::Fifo : public ContentStoreImpl<tinylfu_fifo_policy_traits> { };
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy with TinyLFU admission filter
+ */
+class TinyLfu::Lfu : public ContentStoreImpl<tinylfu_lfu_policy_traits> { };
+
+/**
+ * \brief Variant of Lru Content Store that uses path-compressed trie (radix_trie)
+ */
+class LruRadix : public ContentStoreImpl<lru_policy_traits, radix_trie> { };
+
+/**
+ * \brief Variant of Fifo Content Store that uses path-compressed trie (radix_trie)
+ */
+class FifoRadix : public ContentStoreImpl<fifo_policy_traits, radix_trie> { };
+
+/**
+ * \brief Variant of Random Content Store that uses path-compressed trie (radix_trie)
+ */
+class RandomRadix : public ContentStoreImpl<random_policy_traits, radix_trie> { };
+
+/**
+ * \brief Variant of Lfu Content Store that uses path-compressed trie (radix_trie)
+ */
+class LfuRadix : public ContentStoreImpl<lfu_policy_traits, radix_trie> { };
+
+/**
+ * \brief Variant of LfuBucket Content Store that uses path-compressed trie (radix_trie)
+ */
+class LfuBucketRadix : public ContentStoreImpl<lfu_bucket_policy_traits, radix_trie> { };
+
+/**
+ * \brief Variant of Arc Content Store that uses path-compressed trie (radix_trie)
+ */
+class ArcRadix : public ContentStoreImpl<arc_policy_traits, radix_trie> { };
 #endif
 
 
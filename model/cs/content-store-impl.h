@@ -32,13 +32,19 @@
 #include "ns3/string.h"
 
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/trie/radix-trie.h"
+#include "../../utils/trie/trie-allocator.h"
 
 namespace ns3 {
 namespace ndn {
 namespace cs {
 
+/**
+ * @brief Content store entry, which knows its place in the trie (entries are allocated from a pool)
+ */
 template<class CS>
-class EntryImpl : public Entry
+class EntryImpl : public Entry,
+                  public ndnSIM::pool_allocated< EntryImpl<CS> >
 {
 public:
   typedef Entry base_type;
@@ -65,18 +71,25 @@ private:
 
 
 
-template<class Policy>
+template<class Policy,
+         template<typename, typename, typename, typename, typename> class Engine = ndnSIM::trie>
 class ContentStoreImpl : public ContentStore,
                          protected ndnSIM::trie_with_policy< Name,
-                                                             ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy > >, Entry >,
-                                                             Policy >
+                                                             ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy, Engine > >, Entry >,
+                                                             Policy,
+                                                             ndnSIM::component_key_traits<Name>,
+                                                             ndnSIM::slab_allocator,
+                                                             Engine >
 {
 public:
   typedef ndnSIM::trie_with_policy< Name,
-                                    ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy > >, Entry >,
-                                    Policy > super;
+                                    ndnSIM::smart_pointer_payload_traits< EntryImpl< ContentStoreImpl< Policy, Engine > >, Entry >,
+                                    Policy,
+                                    ndnSIM::component_key_traits<Name>,
+                                    ndnSIM::slab_allocator,
+                                    Engine > super;
 
-  typedef EntryImpl< ContentStoreImpl< Policy > > entry;
+  typedef EntryImpl< ContentStoreImpl< Policy, Engine > > entry;
 
   static TypeId
   GetTypeId ();
@@ -92,6 +105,14 @@ public:
   virtual inline bool
   Add (Ptr<const ContentObject> header, Ptr<const Packet> packet);
 
+  virtual uint32_t
+  BulkAdd (const std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > > &items);
+
+  using ContentStore::BulkAdd;
+
+  virtual inline Ptr<Entry>
+  Find (const PrefixView &prefix);
+
   // virtual bool
   // Remove (Ptr<Interest> header);
 
@@ -129,35 +150,35 @@ private:
 //////////////////////////////////////////
 
 
-template<class Policy>
-LogComponent ContentStoreImpl< Policy >::g_log = LogComponent (("ndn.cs." + Policy::GetName ()).c_str ());
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+LogComponent ContentStoreImpl<Policy, Engine>::g_log = LogComponent (("ndn.cs." + Policy::GetName () + super::parent_trie::GetName ()).c_str ());
 
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 TypeId
-ContentStoreImpl< Policy >::GetTypeId ()
+ContentStoreImpl<Policy, Engine>::GetTypeId ()
 {
-  static TypeId tid = TypeId (("ns3::ndn::cs::"+Policy::GetName ()).c_str ())
+  static TypeId tid = TypeId (("ns3::ndn::cs::"+Policy::GetName ()+super::parent_trie::GetName ()).c_str ())
     .SetGroupName ("Ndn")
     .SetParent<ContentStore> ()
-    .AddConstructor< ContentStoreImpl< Policy > > ()
+    .AddConstructor< ContentStoreImpl<Policy, Engine> > ()
     .AddAttribute ("MaxSize",
                    "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
                    StringValue ("100"),
-                   MakeUintegerAccessor (&ContentStoreImpl< Policy >::GetMaxSize,
-                                         &ContentStoreImpl< Policy >::SetMaxSize),
+                   MakeUintegerAccessor (&ContentStoreImpl<Policy, Engine>::GetMaxSize,
+                                         &ContentStoreImpl<Policy, Engine>::SetMaxSize),
                    MakeUintegerChecker<uint32_t> ())
 
     .AddTraceSource ("DidAddEntry", "Trace fired every time entry is successfully added to the cache",
-                     MakeTraceSourceAccessor (&ContentStoreImpl< Policy >::m_didAddEntry))
+                     MakeTraceSourceAccessor (&ContentStoreImpl<Policy, Engine>::m_didAddEntry))
     ;
 
   return tid;
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 boost::tuple<Ptr<Packet>, Ptr<const ContentObject>, Ptr<const Packet> >
-ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
+ContentStoreImpl<Policy, Engine>::Lookup (Ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION (this << interest->GetName ());
 
@@ -181,9 +202,9 @@ ContentStoreImpl<Policy>::Lookup (Ptr<const Interest> interest)
     }
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 bool
-ContentStoreImpl<Policy>::Add (Ptr<const ContentObject> header, Ptr<const Packet> packet)
+ContentStoreImpl<Policy, Engine>::Add (Ptr<const ContentObject> header, Ptr<const Packet> packet)
 {
   NS_LOG_FUNCTION (this << header->GetName ());
 
@@ -210,9 +231,57 @@ ContentStoreImpl<Policy>::Add (Ptr<const ContentObject> header, Ptr<const Packet
     return false; // cannot insert entry
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+uint32_t
+ContentStoreImpl<Policy, Engine>::BulkAdd (const std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > > &items)
+{
+  NS_LOG_FUNCTION (this << items.size ());
+
+  std::vector< std::pair< Name, Ptr<entry> > > newEntries;
+  newEntries.reserve (items.size ());
+  for (typename std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > >::const_iterator item = items.begin ();
+       item != items.end ();
+       item++)
+    {
+      newEntries.push_back (std::make_pair (item->first->GetName (), Create< entry > (this, item->first, item->second)));
+    }
+
+  std::vector< std::pair< typename super::iterator, bool > > results;
+  super::bulk_load (newEntries.begin (), newEntries.end (), &results);
+
+  uint32_t count = 0;
+  for (size_t i = 0; i < results.size (); i++)
+    {
+      if (!results[i].second)
+        continue;
+
+      // entry could have been already evicted by one of the next items
+      typename super::iterator node = super::find_exact (newEntries[i].first);
+      if (node == super::end () || node->payload () != newEntries[i].second)
+        continue;
+
+      newEntries[i].second->SetTrie (node);
+      m_didAddEntry (newEntries[i].second);
+      count ++;
+    }
+  return count;
+}
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+Ptr<Entry>
+ContentStoreImpl<Policy, Engine>::Find (const PrefixView &prefix)
+{
+  typename super::iterator item = super::find_exact (prefix);
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-ContentStoreImpl<Policy>::Print (std::ostream &os) const
+ContentStoreImpl<Policy, Engine>::Print (std::ostream &os) const
 {
   for (typename super::policy_container::const_iterator item = this->getPolicy ().begin ();
        item != this->getPolicy ().end ();
@@ -222,30 +291,30 @@ ContentStoreImpl<Policy>::Print (std::ostream &os) const
     }
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-ContentStoreImpl<Policy>::SetMaxSize (uint32_t maxSize)
+ContentStoreImpl<Policy, Engine>::SetMaxSize (uint32_t maxSize)
 {
   this->getPolicy ().set_max_size (maxSize);
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 uint32_t
-ContentStoreImpl<Policy>::GetMaxSize () const
+ContentStoreImpl<Policy, Engine>::GetMaxSize () const
 {
   return this->getPolicy ().get_max_size ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 uint32_t
-ContentStoreImpl<Policy>::GetSize () const
+ContentStoreImpl<Policy, Engine>::GetSize () const
 {
   return this->getPolicy ().size ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Begin ()
+ContentStoreImpl<Policy, Engine>::Begin ()
 {
   typename super::parent_trie::recursive_iterator item (super::getTrie ()), end (0);
   for (; item != end; item++)
@@ -260,16 +329,16 @@ ContentStoreImpl<Policy>::Begin ()
     return item->payload ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-ContentStoreImpl<Policy>::End ()
+ContentStoreImpl<Policy, Engine>::End ()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Next (Ptr<Entry> from)
+ContentStoreImpl<Policy, Engine>::Next (Ptr<Entry> from)
 {
   if (from == 0) return 0;
 
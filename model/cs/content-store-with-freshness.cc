@@ -24,6 +24,7 @@
 #include "../../utils/trie/lru-policy.h"
 #include "../../utils/trie/fifo-policy.h"
 #include "../../utils/trie/lfu-policy.h"
+#include "../../utils/trie/arc-policy.h"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
   static struct X ## type ## templ ## RegistrationClass \
@@ -62,12 +63,18 @@ template class ContentStoreWithFreshness<fifo_policy_traits>;
  **/
 template class ContentStoreWithFreshness<lfu_policy_traits>;
 
+/**
+ * @brief ContentStore with freshness and Adaptive Replacement Cache (ARC) policy
+ **/
+template class ContentStoreWithFreshness<arc_policy_traits>;
+
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, fifo_policy_traits);
 
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, lfu_policy_traits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreWithFreshness, arc_policy_traits);
 
 #ifdef DOXYGEN
 // /**
@@ -90,6 +97,11 @@ class Freshness::Random : public ContentStoreWithFreshness<random_policy_traits>
  */
 class Freshness::Lfu : public ContentStoreWithFreshness<lfu_policy_traits> { };
 
+/**
+ * \brief Content Store with freshness implementing Adaptive Replacement Cache (ARC) policy
+ */
+class Freshness::Arc : public ContentStoreWithFreshness<arc_policy_traits> { };
+
 #endif
 
 
@@ -22,6 +22,7 @@
 
 #include "ndn-content-store.h"
 #include "ns3/log.h"
+#include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/ndn-name.h"
 #include "ns3/ndn-interest.h"
@@ -56,6 +57,35 @@ ContentStore::~ContentStore ()
 {
 }
 
+uint32_t
+ContentStore::BulkAdd (const std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > > &items)
+{
+  uint32_t count = 0;
+  for (std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > >::const_iterator item = items.begin ();
+       item != items.end ();
+       item++)
+    {
+      if (Add (item->first, item->second))
+        count ++;
+    }
+  return count;
+}
+
+uint32_t
+ContentStore::BulkAdd (const std::vector< Ptr<const ContentObject> > &headers, const std::vector< Ptr<const Packet> > &packets)
+{
+  NS_ASSERT_MSG (headers.size () == packets.size (), "Each ContentObject header should have a packet");
+
+  std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > > items;
+  items.reserve (headers.size ());
+  for (size_t i = 0; i < headers.size (); i++)
+    {
+      items.push_back (std::make_pair (headers[i], packets[i]));
+    }
+
+  return BulkAdd (items);
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
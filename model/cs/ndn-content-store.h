@@ -27,6 +27,7 @@
 #include "ns3/traced-callback.h"
 
 #include <boost/tuple/tuple.hpp>
+#include <vector>
 
 namespace ns3 {
 
@@ -42,6 +43,7 @@ typedef ContentObject ContentObjectHeader;
 
 class Name;
 typedef Name NameComponents;
+class PrefixView;
 
 class ContentStore;
 
@@ -72,6 +74,11 @@ public:
    */
   Entry (Ptr<ContentStore> cs, Ptr<const ContentObject> header, Ptr<const Packet> packet);
 
+  /**
+   * @brief Virtual destructor (implementations may use their own allocation, see ndnSIM::pool_allocated)
+   */
+  virtual ~Entry () { }
+
   /**
    * \brief Get prefix of the stored entry
    * \returns prefix of the stored entry
@@ -161,6 +168,40 @@ public:
   virtual bool
   Add (Ptr<const ContentObject> header, Ptr<const Packet> packet) = 0;
 
+  /**
+   * \brief Add many content objects at once (e.g., to warm up the cache before the simulation starts)
+   *
+   * Result is the same as calling Add for each item in order.  Default implementation does exactly
+   * that, trie-based content stores (with both plain and radix trie engines) build all new entries
+   * in a single pass.
+   *
+   * @param items Pairs of fully parsed ContentObject and fully formed Ndn packet
+   * @returns number of new entries in the content store
+   */
+  virtual uint32_t
+  BulkAdd (const std::vector< std::pair< Ptr<const ContentObject>, Ptr<const Packet> > > &items);
+
+  /**
+   * \brief Add many content objects at once (needed for python bindings)
+   *
+   * @param headers Fully parsed ContentObjects
+   * @param packets Fully formed Ndn packets (the same number as headers)
+   * @returns number of new entries in the content store
+   */
+  uint32_t
+  BulkAdd (const std::vector< Ptr<const ContentObject> > &headers, const std::vector< Ptr<const Packet> > &packets);
+
+  /**
+   * @brief Get content store entry for the prefix view (exact match)
+   *
+   * Unlike Lookup, this call does not update the replacement policy and does not fire cache hit/miss traces
+   *
+   * @param prefix Prefix of a name (no copies of the name are made during lookup)
+   * @returns If entry is found, a valid iterator (Ptr<cs::Entry>) will be returned. Otherwise End () (==0)
+   */
+  virtual Ptr<cs::Entry>
+  Find (const PrefixView &prefix) = 0;
+
   // /*
   //  * \brief Add a new content to the content store.
   //  *
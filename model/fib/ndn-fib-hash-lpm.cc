@@ -0,0 +1,551 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-fib-hash-lpm.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-forwarding-strategy.h"
+
+#include "ns3/node.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <boost/ref.hpp>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.fib.HashLpm");
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+NS_OBJECT_ENSURE_REGISTERED (HashLpm);
+
+TypeId
+HashLpm::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::fib::HashLpm")
+    .SetParent<Fib> ()
+    .SetGroupName ("Ndn")
+    .AddConstructor<HashLpm> ()
+  ;
+  return tid;
+}
+
+HashLpm::HashLpm ()
+  : m_tables (1) // table for the root prefix
+  , m_size (0)
+{
+}
+
+void
+HashLpm::DoDispose (void)
+{
+  m_tables.clear (); // entries have references to FIB
+  m_uncovered.m_firstCovered = 0;
+  m_size = 0;
+  Fib::DoDispose ();
+}
+
+bool
+HashLpm::PrefixEqual::operator() (const PrefixView &a, const Name &b) const
+{
+  if (a.size () != b.size () ||
+      a.GetPrefixHash (a.size ()) != b.GetPrefixHash (b.size ()))
+    return false;
+
+  for (size_t i = a.size (); i > 0; i--) // last components are more likely to differ
+    {
+      if (a.get (i - 1) != b.get (i - 1))
+        return false;
+    }
+  return true;
+}
+
+Entry *
+HashLpm::GetBestMatch (const Slot &slot) const
+{
+  if (slot.m_entry != 0)
+    return PeekPointer (slot.m_entry);
+  else
+    return PeekPointer (slot.m_bestMatch->m_entry); // 0 for m_uncovered
+}
+
+HashLpm::Slot &
+HashLpm::GetSlot (const Name &prefix)
+{
+  std::pair<Table::iterator, bool> item = m_tables[prefix.size ()].insert (std::make_pair (prefix, Slot ()));
+  item.first->second.m_key = &item.first->first;
+  return item.first->second;
+}
+
+HashLpm::Slot &
+HashLpm::FindCovering (const Name &prefix, size_t length)
+{
+  while (length > 0)
+    {
+      length --;
+      Table::iterator item = m_tables[length].find (PrefixView (prefix, length), PrefixHash (), PrefixEqual ());
+      if (item != m_tables[length].end () && item->second.m_entry != 0)
+        return item->second;
+    }
+  return m_uncovered;
+}
+
+void
+HashLpm::Link (Slot &marker, Slot &covering)
+{
+  NS_ASSERT (marker.m_bestMatch == 0);
+
+  marker.m_bestMatch = &covering;
+  marker.m_prevCovered = 0;
+  marker.m_nextCovered = covering.m_firstCovered;
+  if (covering.m_firstCovered != 0)
+    covering.m_firstCovered->m_prevCovered = &marker;
+  covering.m_firstCovered = &marker;
+}
+
+void
+HashLpm::Unlink (Slot &marker)
+{
+  if (marker.m_bestMatch == 0)
+    return;
+
+  if (marker.m_prevCovered != 0)
+    marker.m_prevCovered->m_nextCovered = marker.m_nextCovered;
+  else
+    marker.m_bestMatch->m_firstCovered = marker.m_nextCovered;
+
+  if (marker.m_nextCovered != 0)
+    marker.m_nextCovered->m_prevCovered = marker.m_prevCovered;
+
+  marker.m_bestMatch = 0;
+  marker.m_prevCovered = 0;
+  marker.m_nextCovered = 0;
+}
+
+void
+HashLpm::UpdateMarkers (const Name &prefix, bool add)
+{
+  size_t length = prefix.size ();
+  size_t low = 1;
+  size_t high = m_tables.size () - 1;
+
+  while (low <= high)
+    {
+      size_t middle = (low + high) / 2;
+      if (middle == length)
+        break;
+
+      if (middle > length)
+        {
+          high = middle - 1;
+          continue;
+        }
+
+      Name marker = prefix.cut (length - middle);
+      if (add)
+        {
+          Slot &slot = GetSlot (marker);
+          if (slot.m_entry == 0 && slot.m_bestMatch == 0)
+            Link (slot, FindCovering (marker, middle));
+
+          slot.m_markers ++;
+        }
+      else
+        {
+          Table::iterator item = m_tables[middle].find (marker);
+          NS_ASSERT (item != m_tables[middle].end () && item->second.m_markers > 0);
+
+          item->second.m_markers --;
+          if (item->second.m_markers == 0 && item->second.m_entry == 0)
+            {
+              Unlink (item->second);
+              m_tables[middle].erase (item);
+            }
+        }
+
+      low = middle + 1;
+    }
+}
+
+void
+HashLpm::RebuildMarkers ()
+{
+  NS_LOG_FUNCTION (this << m_tables.size ());
+
+  for (size_t length = 1; length < m_tables.size (); length++)
+    {
+      Table &table = m_tables[length];
+      for (Table::iterator item = table.begin (); item != table.end (); )
+        {
+          // all links are dropped, markers are linked again when placed
+          item->second.m_markers = 0;
+          item->second.m_bestMatch = 0;
+          item->second.m_prevCovered = 0;
+          item->second.m_nextCovered = 0;
+          item->second.m_firstCovered = 0;
+          if (item->second.m_entry == 0)
+            item = table.erase (item);
+          else
+            item++;
+        }
+    }
+  if (!m_tables[0].empty ())
+    m_tables[0].begin ()->second.m_firstCovered = 0;
+  m_uncovered.m_firstCovered = 0;
+
+  for (size_t length = 1; length < m_tables.size (); length++)
+    {
+      std::vector<Name> prefixes;
+      for (Table::iterator item = m_tables[length].begin (); item != m_tables[length].end (); item++)
+        {
+          prefixes.push_back (item->first);
+        }
+
+      for (std::vector<Name>::iterator prefix = prefixes.begin (); prefix != prefixes.end (); prefix++)
+        {
+          UpdateMarkers (*prefix, true);
+        }
+    }
+}
+
+Ptr<Entry>
+HashLpm::LongestPrefixMatch (const Interest &interest)
+{
+  const Name &name = interest.GetName ();
+
+  Entry *bestMatch = 0;
+  if (!m_tables[0].empty ())
+    bestMatch = PeekPointer (m_tables[0].begin ()->second.m_entry); // root prefix
+
+  // search range should be the same as in UpdateMarkers, otherwise markers can be missed
+  size_t low = 1;
+  size_t high = m_tables.size () - 1;
+  while (low <= high)
+    {
+      size_t middle = (low + high) / 2;
+      if (middle > name.size ())
+        {
+          high = middle - 1;
+          continue;
+        }
+
+      Table::iterator item = m_tables[middle].find (PrefixView (name, middle), PrefixHash (), PrefixEqual ());
+      if (item != m_tables[middle].end ())
+        {
+          Entry *match = GetBestMatch (item->second);
+          if (match != 0)
+            bestMatch = match;
+
+          low = middle + 1;
+        }
+      else
+        {
+          high = middle - 1;
+        }
+    }
+
+  return bestMatch;
+}
+
+template<class NameLike>
+Ptr<Entry>
+HashLpm::FindExact (const NameLike &prefix)
+{
+  if (prefix.size () >= m_tables.size ())
+    return 0;
+
+  Table &table = m_tables[prefix.size ()];
+  Table::iterator item = table.find (prefix, PrefixHash (), PrefixEqual ());
+  if (item == table.end ())
+    return 0;
+  else
+    return item->second.m_entry;
+}
+
+Ptr<fib::Entry>
+HashLpm::Find (const Name &prefix)
+{
+  return FindExact (prefix);
+}
+
+Ptr<fib::Entry>
+HashLpm::Find (const PrefixView &prefix)
+{
+  return FindExact (prefix);
+}
+
+Ptr<Entry>
+HashLpm::Add (const Name &prefix, Ptr<Face> face, int32_t metric)
+{
+  return Add (Create<Name> (prefix), face, metric);
+}
+
+Ptr<Entry>
+HashLpm::Add (const PrefixView &prefix, Ptr<Face> face, int32_t metric)
+{
+  return Add (Create<Name> (prefix.ToName ()), face, metric);
+}
+
+Ptr<Entry>
+HashLpm::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+{
+  NS_LOG_FUNCTION (this << boost::cref(*prefix) << boost::cref(*face) << metric);
+
+  size_t length = prefix->size ();
+  if (length >= m_tables.size ())
+    {
+      // binary search range changes, all markers need to be placed again
+      m_tables.resize (length + 1);
+      RebuildMarkers ();
+    }
+
+  Slot &slot = GetSlot (*prefix);
+  bool isNew = (slot.m_entry == 0);
+  if (isNew)
+    {
+      Slot &covering = FindCovering (*prefix, length);
+
+      Unlink (slot); // the slot could have been a marker
+      slot.m_entry = Create<Entry> (this, prefix);
+      m_size ++;
+
+      // only markers under the new prefix change their best match
+      for (Slot *marker = covering.m_firstCovered; marker != 0; )
+        {
+          Slot *next = marker->m_nextCovered;
+          if (marker->m_key->size () > length &&
+              PrefixEqual () (PrefixView (*marker->m_key, length), *prefix))
+            {
+              Unlink (*marker);
+              Link (*marker, slot);
+            }
+          marker = next;
+        }
+
+      UpdateMarkers (*prefix, true);
+    }
+
+  Ptr<Entry> entry = slot.m_entry;
+  entry->AddOrUpdateRoutingMetric (face, metric);
+
+  if (isNew)
+    {
+      // notify forwarding strategy about new FIB entry
+      NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+      this->GetObject<ForwardingStrategy> ()->DidAddFibEntry (entry);
+    }
+
+  return entry;
+}
+
+void
+HashLpm::BulkAdd (const std::vector<Route> &routes)
+{
+  NS_LOG_FUNCTION (this << routes.size ());
+
+  size_t maxLength = 0;
+  for (std::vector<Route>::const_iterator route = routes.begin (); route != routes.end (); route++)
+    {
+      maxLength = std::max (maxLength, route->m_prefix->size ());
+    }
+
+  if (maxLength >= m_tables.size ())
+    {
+      // extend binary search range once for the whole batch, not for every longer prefix
+      m_tables.resize (maxLength + 1);
+      RebuildMarkers ();
+    }
+
+  for (std::vector<Route>::const_iterator route = routes.begin (); route != routes.end (); route++)
+    {
+      Add (route->m_prefix, route->m_face, route->m_metric);
+    }
+}
+
+void
+HashLpm::Remove (const Ptr<const Name> &prefix)
+{
+  NS_LOG_FUNCTION (this << boost::cref(*prefix));
+
+  size_t length = prefix->size ();
+  if (length >= m_tables.size ())
+    return;
+
+  Table::iterator item = m_tables[length].find (*prefix);
+  if (item == m_tables[length].end () || item->second.m_entry == 0)
+    return;
+
+  // notify forwarding strategy about soon be removed FIB entry
+  NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
+  this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (item->second.m_entry);
+
+  Name key = item->first;
+  Slot &slot = item->second;
+  Slot &covering = FindCovering (key, length);
+
+  // markers covered by the removed prefix fall back to the next shorter prefix
+  while (slot.m_firstCovered != 0)
+    {
+      Slot *marker = slot.m_firstCovered;
+      Unlink (*marker);
+      Link (*marker, covering);
+    }
+
+  if (slot.m_markers == 0)
+    m_tables[length].erase (item);
+  else
+    {
+      slot.m_entry = 0;
+      Link (slot, covering);
+    }
+
+  m_size --;
+
+  UpdateMarkers (key, false);
+}
+
+void
+HashLpm::InvalidateAll ()
+{
+  NS_LOG_FUNCTION (this);
+
+  for (Tables::iterator table = m_tables.begin (); table != m_tables.end (); table++)
+    {
+      for (Table::iterator item = table->begin (); item != table->end (); item++)
+        {
+          if (item->second.m_entry == 0) continue;
+
+          item->second.m_entry->Invalidate ();
+        }
+    }
+}
+
+void
+HashLpm::RemoveFromAll (Ptr<Face> face)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::vector< Ptr<const Name> > emptyEntries;
+  for (Tables::iterator table = m_tables.begin (); table != m_tables.end (); table++)
+    {
+      for (Table::iterator item = table->begin (); item != table->end (); item++)
+        {
+          if (item->second.m_entry == 0) continue;
+
+          item->second.m_entry->RemoveFace (face);
+          if (item->second.m_entry->m_faces.size () == 0)
+            emptyEntries.push_back (item->second.m_entry->m_prefix);
+        }
+    }
+
+  for (std::vector< Ptr<const Name> >::iterator prefix = emptyEntries.begin (); prefix != emptyEntries.end (); prefix++)
+    {
+      Remove (*prefix);
+    }
+}
+
+void
+HashLpm::Print (std::ostream &os) const
+{
+  for (Tables::const_iterator table = m_tables.begin (); table != m_tables.end (); table++)
+    {
+      for (Table::const_iterator item = table->begin (); item != table->end (); item++)
+        {
+          if (item->second.m_entry == 0) continue;
+
+          os << item->first << "\t" << *item->second.m_entry << "\n";
+        }
+    }
+}
+
+uint32_t
+HashLpm::GetSize () const
+{
+  return m_size;
+}
+
+Ptr<Entry>
+HashLpm::FindFrom (size_t length, Table::const_iterator position) const
+{
+  while (true)
+    {
+      for (; position != m_tables[length].end (); position++)
+        {
+          if (position->second.m_entry != 0)
+            return position->second.m_entry;
+        }
+
+      length ++;
+      if (length >= m_tables.size ())
+        return 0;
+      position = m_tables[length].begin ();
+    }
+}
+
+Ptr<const Entry>
+HashLpm::Begin () const
+{
+  return FindFrom (0, m_tables[0].begin ());
+}
+
+Ptr<Entry>
+HashLpm::Begin ()
+{
+  return FindFrom (0, m_tables[0].begin ());
+}
+
+Ptr<const Entry>
+HashLpm::End () const
+{
+  return 0;
+}
+
+Ptr<Entry>
+HashLpm::End ()
+{
+  return 0;
+}
+
+Ptr<const Entry>
+HashLpm::Next (Ptr<const Entry> from) const
+{
+  if (from == 0) return 0;
+
+  const Name &prefix = from->GetPrefix ();
+  Table::const_iterator item = m_tables[prefix.size ()].find (prefix);
+  NS_ASSERT (item != m_tables[prefix.size ()].end ());
+
+  item++;
+  return FindFrom (prefix.size (), item);
+}
+
+Ptr<Entry>
+HashLpm::Next (Ptr<Entry> from)
+{
+  return ConstCast<Entry> (static_cast<const HashLpm*> (this)->Next (ConstCast<const Entry> (from)));
+}
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,224 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_FIB_HASH_LPM_H_
+#define	_NDN_FIB_HASH_LPM_H_
+
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-name.h"
+
+#include <boost/unordered_map.hpp>
+#include <deque>
+
+namespace ns3 {
+namespace ndn {
+namespace fib {
+
+/**
+ * \ingroup ndn
+ * \brief FIB implementation, in which longest prefix match is performed using binary search
+ *        on prefix lengths (Waldvogel et al.)
+ *
+ * Prefixes are stored in a separate hash table for each prefix length.  For each prefix, markers
+ * are placed at all shorter lengths visited by the binary search, so that the search knows that
+ * a longer match may exist.  Each marker caches the best (longest) real prefix it is covered by,
+ * so longest prefix match costs O(log L) hash probes, where L is the longest prefix in FIB.
+ *
+ * Every marker is linked to the slot of the real prefix it is currently covered by.  When a prefix
+ * is added or removed, only markers under this prefix are relinked, markers are rebuilt only when
+ * a prefix longer than all existing ones is added.
+ *
+ * To use this implementation instead of the default trie-based FIB:
+ *
+ *     ndnHelper.SetFib ("ns3::ndn::fib::HashLpm");
+ */
+class HashLpm : public Fib
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor
+   */
+  HashLpm ();
+
+  virtual Ptr<Entry>
+  LongestPrefixMatch (const Interest &interest);
+
+  virtual Ptr<fib::Entry>
+  Find (const Name &prefix);
+
+  virtual Ptr<fib::Entry>
+  Find (const PrefixView &prefix);
+
+  virtual Ptr<Entry>
+  Add (const Name &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual Ptr<Entry>
+  Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual Ptr<Entry>
+  Add (const PrefixView &prefix, Ptr<Face> face, int32_t metric);
+
+  /**
+   * @brief Add many routes, markers are rebuilt at most once for the whole batch
+   */
+  virtual void
+  BulkAdd (const std::vector<Route> &routes);
+
+  virtual void
+  Remove (const Ptr<const Name> &prefix);
+
+  virtual void
+  InvalidateAll ();
+
+  virtual void
+  RemoveFromAll (Ptr<Face> face);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<const Entry>
+  Begin () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<const Entry>
+  End () const;
+
+  virtual Ptr<Entry>
+  End ();
+
+  virtual Ptr<const Entry>
+  Next (Ptr<const Entry> item) const;
+
+  virtual Ptr<Entry>
+  Next (Ptr<Entry> item);
+
+protected:
+  // inherited from Object class
+  virtual void DoDispose (); ///< @brief Perform cleanup
+
+private:
+  /**
+   * @brief Content of the hash table cell: FIB entry and/or marker
+   */
+  struct Slot
+  {
+    Slot () : m_key (0), m_markers (0), m_bestMatch (0), m_prevCovered (0), m_nextCovered (0), m_firstCovered (0) { }
+
+    const Name *m_key;      ///< @brief Key of the slot in the hash table
+    Ptr<Entry> m_entry;     ///< @brief FIB entry (0 if the slot is only a marker)
+    uint32_t m_markers;     ///< @brief Number of longer prefixes that placed a marker in the slot
+
+    Slot *m_bestMatch;      ///< @brief Slot with the longest real prefix covering the marker (0 if the slot has FIB entry)
+    Slot *m_prevCovered;    ///< @brief Previous marker covered by the same m_bestMatch
+    Slot *m_nextCovered;    ///< @brief Next marker covered by the same m_bestMatch
+    Slot *m_firstCovered;   ///< @brief First marker, for which the slot is m_bestMatch (only slots with FIB entry)
+  };
+
+  struct PrefixHash
+  {
+    std::size_t operator() (const Name &prefix) const { return prefix.GetPrefixHash (prefix.size ()); }
+    std::size_t operator() (const PrefixView &prefix) const { return prefix.GetPrefixHash (prefix.size ()); }
+  };
+
+  struct PrefixEqual
+  {
+    bool operator() (const Name &a, const Name &b) const { return a == b; }
+    bool operator() (const PrefixView &a, const Name &b) const;
+  };
+
+  typedef boost::unordered_map<Name, Slot, PrefixHash, PrefixEqual> Table;
+  typedef std::deque<Table> Tables; // deque does not move existing tables when new lengths are added
+
+  /**
+   * @brief Get best match for the slot
+   */
+  inline Entry *
+  GetBestMatch (const Slot &slot) const;
+
+  /**
+   * @brief Get slot for the prefix, creating an empty slot if necessary
+   */
+  Slot &
+  GetSlot (const Name &prefix);
+
+  /**
+   * @brief Find slot with the longest real prefix that covers first `length` components of `prefix`,
+   *        excluding the prefix itself (m_uncovered if there is no such prefix)
+   */
+  Slot &
+  FindCovering (const Name &prefix, size_t length);
+
+  /**
+   * @brief Make `covering` the best match of the marker
+   */
+  void
+  Link (Slot &marker, Slot &covering);
+
+  /**
+   * @brief Remove the marker from the list of its current best match
+   */
+  void
+  Unlink (Slot &marker);
+
+  /**
+   * @brief Add (or remove) markers of the prefix on its binary search path
+   */
+  void
+  UpdateMarkers (const Name &prefix, bool add);
+
+  /**
+   * @brief Remove all markers and place them again (necessary when maximum prefix length changes)
+   */
+  void
+  RebuildMarkers ();
+
+  /**
+   * @brief Find slot with FIB entry (not a marker), starting from the position in length-th table
+   */
+  Ptr<Entry>
+  FindFrom (size_t length, Table::const_iterator position) const;
+
+  template<class NameLike>
+  Ptr<Entry>
+  FindExact (const NameLike &prefix);
+
+private:
+  Tables m_tables;    ///< @brief Hash table for each prefix length (index is number of components)
+  Slot m_uncovered;   ///< @brief Head of the list of markers not covered by any real prefix
+  uint32_t m_size;    ///< @brief Number of FIB entries
+};
+
+} // namespace fib
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_FIB_HASH_LPM_H_ */
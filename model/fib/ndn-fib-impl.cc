@@ -20,6 +20,8 @@
 
 #include "ndn-fib-impl.h"
 
+#include "../../utils/trie/interned-key-traits.h"
+
 #include "ns3/ndn-face.h"
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-forwarding-strategy.h"
@@ -34,47 +36,47 @@
 #include <boost/lambda/bind.hpp>
 namespace ll = boost::lambda;
 
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)  \
+  static struct X ## type ## templ ## RegistrationClass \
+  {                                                     \
+    X ## type ## templ ## RegistrationClass () {        \
+      ns3::TypeId tid = type<templ>::GetTypeId ();      \
+      tid.GetParent ();                                 \
+    }                                                   \
+  } x_ ## type ## templ ## RegistrationVariable
+
 NS_LOG_COMPONENT_DEFINE ("ndn.fib.FibImpl");
 
 namespace ns3 {
 namespace ndn {
 namespace fib {
 
-NS_OBJECT_ENSURE_REGISTERED (FibImpl);
-
-TypeId 
-FibImpl::GetTypeId (void)
-{
-  static TypeId tid = TypeId ("ns3::ndn::fib::Default") // cheating ns3 object system
-    .SetParent<Fib> ()
-    .SetGroupName ("Ndn")
-    .AddConstructor<FibImpl> ()
-  ;
-  return tid;
-}
-
-FibImpl::FibImpl ()
+template<class KeyTraits>
+FibImpl<KeyTraits>::FibImpl ()
 {
 }
 
+template<class KeyTraits>
 void
-FibImpl::NotifyNewAggregate ()
+FibImpl<KeyTraits>::NotifyNewAggregate ()
 {
   Object::NotifyNewAggregate ();
 }
 
+template<class KeyTraits>
 void 
-FibImpl::DoDispose (void)
+FibImpl<KeyTraits>::DoDispose (void)
 {
-  clear ();
+  super::clear ();
   Object::DoDispose ();
 }
 
 
+template<class KeyTraits>
 Ptr<Entry>
-FibImpl::LongestPrefixMatch (const Interest &interest)
+FibImpl<KeyTraits>::LongestPrefixMatch (const Interest &interest)
 {
-  super::iterator item = super::longest_prefix_match (interest.GetName ());
+  typename super::iterator item = super::longest_prefix_match (interest.GetName ());
   // @todo use predicate to search with exclude filters
 
   if (item == super::end ())
@@ -83,10 +85,23 @@ FibImpl::LongestPrefixMatch (const Interest &interest)
     return item->payload ();
 }
 
+template<class KeyTraits>
+Ptr<fib::Entry>
+FibImpl<KeyTraits>::Find (const Name &prefix)
+{
+  typename super::iterator item = super::find_exact (prefix);
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
+
+template<class KeyTraits>
 Ptr<fib::Entry>
-FibImpl::Find (const Name &prefix)
+FibImpl<KeyTraits>::Find (const PrefixView &prefix)
 {
-  super::iterator item = super::find_exact (prefix);
+  typename super::iterator item = super::find_exact (prefix);
 
   if (item == super::end ())
     return 0;
@@ -95,24 +110,33 @@ FibImpl::Find (const Name &prefix)
 }
 
 
+template<class KeyTraits>
 Ptr<Entry>
-FibImpl::Add (const Name &prefix, Ptr<Face> face, int32_t metric)
+FibImpl<KeyTraits>::Add (const Name &prefix, Ptr<Face> face, int32_t metric)
 {
   return Add (Create<Name> (prefix), face, metric);
 }
+
+template<class KeyTraits>
+Ptr<Entry>
+FibImpl<KeyTraits>::Add (const PrefixView &prefix, Ptr<Face> face, int32_t metric)
+{
+  return Add (Create<Name> (prefix.ToName ()), face, metric);
+}
   
+template<class KeyTraits>
 Ptr<Entry>
-FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+FibImpl<KeyTraits>::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
 {
   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix) << boost::cref(*face) << metric);
 
   // will add entry if doesn't exists, or just return an iterator to the existing entry
-  std::pair< super::iterator, bool > result = super::insert (*prefix, 0);
+  std::pair< typename super::iterator, bool > result = super::insert (*prefix, 0);
   if (result.first != super::end ())
     {
       if (result.second)
         {
-          Ptr<EntryImpl> newEntry = Create<EntryImpl> (this, prefix);
+          Ptr<EntryImpl<KeyTraits> > newEntry = Create<EntryImpl<KeyTraits> > (this, prefix);
           newEntry->SetTrie (result.first);
           result.first->set_payload (newEntry);
         }
@@ -133,12 +157,48 @@ FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
     return 0;
 }
 
+template<class KeyTraits>
+void
+FibImpl<KeyTraits>::BulkAdd (const std::vector<Route> &routes)
+{
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << routes.size ());
+
+  std::vector< std::pair<Name, Ptr<EntryImpl<KeyTraits> > > > items;
+  items.reserve (routes.size ());
+  for (std::vector<Route>::const_iterator route = routes.begin (); route != routes.end (); route++)
+    {
+      items.push_back (std::make_pair (*route->m_prefix, Create<EntryImpl<KeyTraits> > (this, route->m_prefix)));
+    }
+
+  std::vector< std::pair<typename super::iterator, bool> > results;
+  super::bulk_load (items.begin (), items.end (), &results);
+
+  for (size_t i = 0; i < results.size (); i++)
+    {
+      if (results[i].second)
+        items[i].second->SetTrie (results[i].first);
+
+      super::modify (results[i].first,
+                     ll::bind (&Entry::AddOrUpdateRoutingMetric, ll::_1, routes[i].m_face, routes[i].m_metric));
+    }
+
+  // notify forwarding strategy about new FIB entries (metrics are already set, as in Add)
+  Ptr<ForwardingStrategy> forwardingStrategy = this->GetObject<ForwardingStrategy> ();
+  NS_ASSERT (forwardingStrategy != 0);
+  for (size_t i = 0; i < results.size (); i++)
+    {
+      if (results[i].second)
+        forwardingStrategy->DidAddFibEntry (results[i].first->payload ());
+    }
+}
+
+template<class KeyTraits>
 void
-FibImpl::Remove (const Ptr<const Name> &prefix)
+FibImpl<KeyTraits>::Remove (const Ptr<const Name> &prefix)
 {
   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix));
 
-  super::iterator fibEntry = super::find_exact (*prefix);
+  typename super::iterator fibEntry = super::find_exact (*prefix);
   if (fibEntry != super::end ())
     {
       // notify forwarding strategy about soon be removed FIB entry
@@ -155,7 +215,7 @@ FibImpl::Remove (const Ptr<const Name> &prefix)
 // {
 //   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix));
 
-//   super::iterator foundItem, lastItem;
+//   typename super::iterator foundItem, lastItem;
 //   bool reachLast;
 //   boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (*prefix);
   
@@ -166,13 +226,14 @@ FibImpl::Remove (const Ptr<const Name> &prefix)
 //                  ll::bind (&Entry::Invalidate, ll::_1));
 // }
 
+template<class KeyTraits>
 void
-FibImpl::InvalidateAll ()
+FibImpl<KeyTraits>::InvalidateAll ()
 {
   NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId ());
 
-  super::parent_trie::recursive_iterator item (super::getTrie ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -182,8 +243,9 @@ FibImpl::InvalidateAll ()
     }
 }
 
+template<class KeyTraits>
 void
-FibImpl::RemoveFace (super::parent_trie &item, Ptr<Face> face)
+FibImpl<KeyTraits>::RemoveFace (typename super::parent_trie &item, Ptr<Face> face)
 {
   if (item.payload () == 0) return;
   NS_LOG_FUNCTION (this);
@@ -192,18 +254,19 @@ FibImpl::RemoveFace (super::parent_trie &item, Ptr<Face> face)
                  ll::bind (&Entry::RemoveFace, ll::_1, face));
 }
 
+template<class KeyTraits>
 void
-FibImpl::RemoveFromAll (Ptr<Face> face)
+FibImpl<KeyTraits>::RemoveFromAll (Ptr<Face> face)
 {
   NS_LOG_FUNCTION (this);
 
-  std::for_each (super::parent_trie::recursive_iterator (super::getTrie ()),
-                 super::parent_trie::recursive_iterator (0), 
-                 ll::bind (&FibImpl::RemoveFace,
+  std::for_each (typename super::parent_trie::recursive_iterator (super::getTrie ()),
+                 typename super::parent_trie::recursive_iterator (0), 
+                 ll::bind (&FibImpl<KeyTraits>::RemoveFace,
                            this, ll::_1, face));
 
-  super::parent_trie::recursive_iterator trieNode (super::getTrie ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator trieNode (super::getTrie ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (; trieNode != end; trieNode++)
     {
       if (trieNode->payload () == 0) continue;
@@ -214,17 +277,18 @@ FibImpl::RemoveFromAll (Ptr<Face> face)
           NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
           this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (trieNode->payload ());
           
-          trieNode = super::parent_trie::recursive_iterator (trieNode->erase ());
+          trieNode = typename super::parent_trie::recursive_iterator (trieNode->erase ());
         }
     }
 }
 
+template<class KeyTraits>
 void
-FibImpl::Print (std::ostream &os) const
+FibImpl<KeyTraits>::Print (std::ostream &os) const
 {
   // !!! unordered_set imposes "random" order of item in the same level !!!
-  super::parent_trie::const_recursive_iterator item (super::getTrie ());
-  super::parent_trie::const_recursive_iterator end (0);
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::const_recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -233,17 +297,19 @@ FibImpl::Print (std::ostream &os) const
     }
 }
 
+template<class KeyTraits>
 uint32_t
-FibImpl::GetSize () const
+FibImpl<KeyTraits>::GetSize () const
 {
   return super::getPolicy ().size ();
 }
 
+template<class KeyTraits>
 Ptr<const Entry>
-FibImpl::Begin () const
+FibImpl<KeyTraits>::Begin () const
 {
-  super::parent_trie::const_recursive_iterator item (super::getTrie ());
-  super::parent_trie::const_recursive_iterator end (0);
+  typename super::parent_trie::const_recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::const_recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -256,19 +322,21 @@ FibImpl::Begin () const
     return item->payload ();
 }
 
+template<class KeyTraits>
 Ptr<const Entry>
-FibImpl::End () const
+FibImpl<KeyTraits>::End () const
 {
   return 0;
 }
 
+template<class KeyTraits>
 Ptr<const Entry>
-FibImpl::Next (Ptr<const Entry> from) const
+FibImpl<KeyTraits>::Next (Ptr<const Entry> from) const
 {
   if (from == 0) return 0;
   
-  super::parent_trie::const_recursive_iterator item (*StaticCast<const EntryImpl> (from)->to_iterator ());
-  super::parent_trie::const_recursive_iterator end (0);
+  typename super::parent_trie::const_recursive_iterator item (*StaticCast<const EntryImpl<KeyTraits> > (from)->to_iterator ());
+  typename super::parent_trie::const_recursive_iterator end (0);
   for (item++; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -281,11 +349,12 @@ FibImpl::Next (Ptr<const Entry> from) const
     return item->payload ();
 }
 
+template<class KeyTraits>
 Ptr<Entry>
-FibImpl::Begin ()
+FibImpl<KeyTraits>::Begin ()
 {
-  super::parent_trie::recursive_iterator item (super::getTrie ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator item (super::getTrie ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -298,19 +367,21 @@ FibImpl::Begin ()
     return item->payload ();
 }
 
+template<class KeyTraits>
 Ptr<Entry>
-FibImpl::End ()
+FibImpl<KeyTraits>::End ()
 {
   return 0;
 }
 
+template<class KeyTraits>
 Ptr<Entry>
-FibImpl::Next (Ptr<Entry> from)
+FibImpl<KeyTraits>::Next (Ptr<Entry> from)
 {
   if (from == 0) return 0;
   
-  super::parent_trie::recursive_iterator item (*StaticCast<EntryImpl> (from)->to_iterator ());
-  super::parent_trie::recursive_iterator end (0);
+  typename super::parent_trie::recursive_iterator item (*StaticCast<EntryImpl<KeyTraits> > (from)->to_iterator ());
+  typename super::parent_trie::recursive_iterator end (0);
   for (item++; item != end; item++)
     {
       if (item->payload () == 0) continue;
@@ -323,6 +394,38 @@ FibImpl::Next (Ptr<Entry> from)
     return item->payload ();
 }
 
+typedef ndnSIM::component_key_traits<Name> ComponentKeyTraits;
+typedef ndnSIM::interned_key_traits<Name> InternedKeyTraits;
+
+template<>
+TypeId
+FibImpl<ComponentKeyTraits>::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::fib::Default") // cheating ns3 object system
+    .SetParent<Fib> ()
+    .SetGroupName ("Ndn")
+    .AddConstructor< FibImpl<ComponentKeyTraits> > ()
+  ;
+  return tid;
+}
+
+template<>
+TypeId
+FibImpl<InternedKeyTraits>::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::fib::Interned") // cheating ns3 object system
+    .SetParent<Fib> ()
+    .SetGroupName ("Ndn")
+    .AddConstructor< FibImpl<InternedKeyTraits> > ()
+  ;
+  return tid;
+}
+
+template class FibImpl<ComponentKeyTraits>;
+template class FibImpl<InternedKeyTraits>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(FibImpl, ComponentKeyTraits);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(FibImpl, InternedKeyTraits);
 
 } // namespace fib
 } // namespace ndn
@@ -31,13 +31,19 @@ namespace ns3 {
 namespace ndn {
 namespace fib {
 
+/**
+ * @brief FIB entry, which knows its place in the trie
+ * @tparam KeyTraits what is stored in the trie nodes (see ndnSIM::component_key_traits and ndnSIM::interned_key_traits)
+ */
+template<class KeyTraits = ndnSIM::component_key_traits<Name> >
 class EntryImpl : public Entry
 {
 public:
   typedef ndnSIM::trie_with_policy<
     Name,
     ndnSIM::smart_pointer_payload_traits<EntryImpl>,
-    ndnSIM::counting_policy_traits
+    ndnSIM::counting_policy_traits,
+    KeyTraits
     > trie;
 
   EntryImpl (Ptr<Fib> fib, const Ptr<const Name> &prefix)
@@ -47,31 +53,35 @@ public:
   }
 
   void
-  SetTrie (trie::iterator item)
+  SetTrie (typename trie::iterator item)
   {
     item_ = item;
   }
 
-  trie::iterator to_iterator () { return item_; }
-  trie::const_iterator to_iterator () const { return item_; }
+  typename trie::iterator to_iterator () { return item_; }
+  typename trie::const_iterator to_iterator () const { return item_; }
   
 private:
-  trie::iterator item_;
+  typename trie::iterator item_;
 };
 
 /**
  * \ingroup ndn
  * \brief Class implementing FIB functionality
+ *
+ * Two variants are available:
+ * - ns3::ndn::fib::Default: trie nodes keep copies of name components
+ * - ns3::ndn::fib::Interned: trie nodes keep references to components interned in name::Dictionary,
+ *   which saves memory when the same components appear in routes of many nodes
+ *
+ * @tparam KeyTraits what is stored in the trie nodes (see ndnSIM::component_key_traits and ndnSIM::interned_key_traits)
  */
+template<class KeyTraits = ndnSIM::component_key_traits<Name> >
 class FibImpl : public Fib,
-                protected ndnSIM::trie_with_policy< Name,
-                                                    ndnSIM::smart_pointer_payload_traits< EntryImpl >,
-                                                    ndnSIM::counting_policy_traits >
+                protected EntryImpl<KeyTraits>::trie
 {
 public:
-  typedef ndnSIM::trie_with_policy< Name,
-                                    ndnSIM::smart_pointer_payload_traits<EntryImpl>,
-                                    ndnSIM::counting_policy_traits > super;
+  typedef typename EntryImpl<KeyTraits>::trie super;
   
   /**
    * \brief Interface ID
@@ -90,6 +100,9 @@ public:
 
   virtual Ptr<fib::Entry>
   Find (const Name &prefix);
+
+  virtual Ptr<fib::Entry>
+  Find (const PrefixView &prefix);
   
   virtual Ptr<Entry>
   Add (const Name &prefix, Ptr<Face> face, int32_t metric);
@@ -97,6 +110,12 @@ public:
   virtual Ptr<Entry>
   Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric);
 
+  virtual Ptr<Entry>
+  Add (const PrefixView &prefix, Ptr<Face> face, int32_t metric);
+
+  virtual void
+  BulkAdd (const std::vector<Route> &routes);
+
   virtual void
   Remove (const Ptr<const Name> &prefix);
 
@@ -141,7 +160,7 @@ private:
    * entry will be removed
    */
   void
-  RemoveFace (super::parent_trie &item, Ptr<Face> face);
+  RemoveFace (typename super::parent_trie &item, Ptr<Face> face);
 };
 
 } // namespace fib
@@ -36,6 +36,15 @@ Fib::GetTypeId (void)
   return tid;
 }
 
+void
+Fib::BulkAdd (const std::vector<Route> &routes)
+{
+  for (std::vector<Route>::const_iterator route = routes.begin (); route != routes.end (); route++)
+    {
+      Add (route->m_prefix, route->m_face, route->m_metric);
+    }
+}
+
 std::ostream&
 operator<< (std::ostream& os, const Fib &fib)
 {
@@ -26,6 +26,8 @@
 
 #include "ns3/ndn-fib-entry.h"
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -74,6 +76,15 @@ public:
    */
   virtual Ptr<fib::Entry>
   Find (const Name &prefix) = 0;
+
+  /**
+   * @brief Get FIB entry for the prefix view (exact match)
+   *
+   * @param prefix Prefix of a name (no copies of the name are made during lookup)
+   * @returns If entry is found, a valid iterator (Ptr<fib::Entry>) will be returned. Otherwise End () (==0)
+   */
+  virtual Ptr<fib::Entry>
+  Find (const PrefixView &prefix) = 0;
   
   /**
    * \brief Add or update FIB entry
@@ -103,6 +114,44 @@ public:
   virtual Ptr<fib::Entry>
   Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric) = 0;
 
+  /**
+   * \brief Add or update FIB entry using prefix view
+   *
+   * If the entry exists, metric will be updated. Otherwise, new entry will be created
+   * (the entry will share storage of components with the name referenced by the view)
+   *
+   * @param prefix	Prefix view
+   * @param face	Forwarding face
+   * @param metric	Routing metric
+   */
+  virtual Ptr<fib::Entry>
+  Add (const PrefixView &prefix, Ptr<Face> face, int32_t metric) = 0;
+
+  /**
+   * @brief Route to be added to FIB with BulkAdd
+   */
+  struct Route
+  {
+    Route (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
+      : m_prefix (prefix), m_face (face), m_metric (metric) { }
+
+    Ptr<const Name> m_prefix; ///< @brief Prefix
+    Ptr<Face> m_face;         ///< @brief Forwarding face
+    int32_t m_metric;         ///< @brief Routing metric
+  };
+
+  /**
+   * \brief Add or update many FIB entries at once (e.g., initial population of large FIBs)
+   *
+   * Result is the same as calling Add for each route in order.  Default implementation does exactly
+   * that, trie-based FIBs build all new entries in a single pass, and fib::HashLpm places markers
+   * for the new maximum prefix length only once.
+   *
+   * @param routes	Routes to add
+   */
+  virtual void
+  BulkAdd (const std::vector<Route> &routes);
+
   /**
    * @brief Remove FIB entry
    *
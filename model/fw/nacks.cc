@@ -113,25 +113,46 @@ Nacks::DidReceiveDuplicateInterest (Ptr<Face> inFace,
 
   if (m_nacksEnabled)
     {
-      NS_LOG_DEBUG ("Sending NACK_LOOP");
-      Ptr<Interest> nackHeader = Create<Interest> (*header);
-      nackHeader->SetNack (Interest::NACK_LOOP);
-      Ptr<Packet> nack = Create<Packet> ();
-      nack->AddHeader (*nackHeader);
+      SendLoopNack (inFace, header, origPacket);
+    }
+}
 
-      FwHopCountTag hopCountTag;
-      if (origPacket->PeekPacketTag (hopCountTag))
-        {
-     	  nack->AddPacketTag (hopCountTag);
-        }
-      else
-        {
-          NS_LOG_DEBUG ("No FwHopCountTag tag associated with received duplicated Interest");
-        }
+void
+Nacks::DidReceiveDeadNonceInterest (Ptr<Face> inFace,
+                                    Ptr<const Interest> header,
+                                    Ptr<const Packet> origPacket)
+{
+  super::DidReceiveDeadNonceInterest (inFace, header, origPacket);
 
-      inFace->Send (nack);
-      m_outNacks (nackHeader, inFace);
+  if (m_nacksEnabled)
+    {
+      SendLoopNack (inFace, header, origPacket);
+    }
+}
+
+void
+Nacks::SendLoopNack (Ptr<Face> inFace,
+                     Ptr<const Interest> header,
+                     Ptr<const Packet> origPacket)
+{
+  NS_LOG_DEBUG ("Sending NACK_LOOP");
+  Ptr<Interest> nackHeader = Create<Interest> (*header);
+  nackHeader->SetNack (Interest::NACK_LOOP);
+  Ptr<Packet> nack = Create<Packet> ();
+  nack->AddHeader (*nackHeader);
+
+  FwHopCountTag hopCountTag;
+  if (origPacket->PeekPacketTag (hopCountTag))
+    {
+      nack->AddPacketTag (hopCountTag);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("No FwHopCountTag tag associated with received duplicated Interest");
     }
+
+  inFace->Send (nack);
+  m_outNacks (nackHeader, inFace);
 }
 
 void
@@ -54,6 +54,12 @@ protected:
                                Ptr<const Packet> packet,
                                Ptr<pit::Entry> pitEntry);
 
+  // from super
+  virtual void
+  DidReceiveDeadNonceInterest (Ptr<Face> inFace,
+                               Ptr<const Interest> header,
+                               Ptr<const Packet> packet);
+
   // from super
   virtual void
   DidExhaustForwardingOptions (Ptr<Face> inFace,
@@ -73,6 +79,15 @@ protected:
                        Ptr<const Packet> origPacket,
                        Ptr<pit::Entry> pitEntry);
   
+private:
+  /**
+   * @brief Send NACK_LOOP back to the face, from which the looping Interest has been received
+   */
+  void
+  SendLoopNack (Ptr<Face> inFace,
+                Ptr<const Interest> header,
+                Ptr<const Packet> origPacket);
+
 protected:  
   bool m_nacksEnabled;
 
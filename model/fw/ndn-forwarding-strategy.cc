@@ -153,7 +153,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
   if (pitEntry == 0)
     {
       similarInterest = false;
-      pitEntry = m_pit->Create (header);
+      pitEntry = m_pit->Create (header, inFace);
       if (pitEntry != 0)
         {
           DidCreatePitEntry (inFace, header, origPacket, pitEntry);
@@ -202,6 +202,18 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
       return;
     }
 
+  // Interest could not be satisfied from the cache, so check if it is a looping copy of an already satisfied one
+  if (m_pit->IsDeadNonce (*header))
+    {
+      if (!similarInterest)
+        {
+          m_pit->MarkErased (pitEntry); // entry has been created just for this Interest
+        }
+
+      DidReceiveDeadNonceInterest (inFace, header, origPacket);
+      return;
+    }
+
   if (similarInterest && ShouldSuppressIncomingInterest (inFace, header, origPacket, pitEntry))
     {
       pitEntry->AddIncoming (inFace/*, header->GetInterestLifetime ()*/);
@@ -233,9 +245,9 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
   NS_LOG_FUNCTION (inFace << header->GetName () << payload << origPacket);
   m_inData (header, payload, inFace);
 
-  // Lookup PIT entry
-  Ptr<pit::Entry> pitEntry = m_pit->Lookup (*header);
-  if (pitEntry == 0)
+  // Lookup all PIT entries that can be satisfied (single walk along the name)
+  std::vector< Ptr<pit::Entry> > pitEntries = m_pit->FindAllMatches (*header);
+  if (pitEntries.empty ())
     {
       bool cached = false;
 
@@ -283,16 +295,19 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
       DidReceiveSolicitedData (inFace, header, payload, origPacket, cached);
     }
 
-  while (pitEntry != 0)
+  for (std::vector< Ptr<pit::Entry> >::iterator pitEntry = pitEntries.begin ();
+       pitEntry != pitEntries.end ();
+       pitEntry++)
     {
+      // entry could have been satisfied while processing other entries
+      if ((*pitEntry)->GetIncoming ().empty ())
+        continue;
+
       // Do data plane performance measurements
-      WillSatisfyPendingInterest (inFace, pitEntry);
+      WillSatisfyPendingInterest (inFace, *pitEntry);
 
       // Actually satisfy pending interest
-      SatisfyPendingInterest (inFace, header, payload, origPacket, pitEntry);
-
-      // Lookup another PIT entry
-      pitEntry = m_pit->Lookup (*header);
+      SatisfyPendingInterest (inFace, header, payload, origPacket, *pitEntry);
     }
 }
 
@@ -312,6 +327,14 @@ ForwardingStrategy::FailedToCreatePitEntry (Ptr<Face> inFace,
   m_dropInterests (header, inFace);
 }
 
+void
+ForwardingStrategy::DidReceiveDeadNonceInterest (Ptr<Face> inFace,
+                                                 Ptr<const Interest> header,
+                                                 Ptr<const Packet> origPacket)
+{
+  m_dropInterests (header, inFace);
+}
+
 void
 ForwardingStrategy::DidReceiveDuplicateInterest (Ptr<Face> inFace,
                                                  Ptr<const Interest> header,
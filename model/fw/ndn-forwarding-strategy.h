@@ -154,7 +154,8 @@ protected:
                      Ptr<pit::Entry> pitEntry);
 
   /**
-   * @brief An event that is fired every time a new PIT entry cannot be created (e.g., PIT container imposes a limit)
+   * @brief An event that is fired every time a new PIT entry cannot be created (e.g., PIT container imposes a limit,
+   *        or the incoming face has reached its limit of PIT entries, see Pit::Create (header, inFace))
    *
    * Note that this call can be called only for non-similar Interest (i.e., there is an attempt to create a new PIT entry).
    * For any non-similar Interests, either FailedToCreatePitEntry or DidCreatePitEntry is called.
@@ -168,6 +169,25 @@ protected:
                           Ptr<const Interest> header,
                           Ptr<const Packet> origPacket);
 
+  /**
+   * @brief An event that is fired every time a looping Interest is detected, for which PIT entry
+   *        has been already satisfied (nonce is found in the dead nonce list of PIT)
+   *
+   * This even is the last action that is performed before the Interest processing is halted.
+   * The check is done only if the Interest cannot be satisfied from the content store.
+   * If PIT entry still has the nonce, DidReceiveDuplicateInterest is called instead
+   *
+   * @param inFace  incoming face
+   * @param header  deserialized Interest header
+   * @param origPacket  original packet
+   *
+   * @see Pit::IsDeadNonce, DidReceiveDuplicateInterest
+   */
+  virtual void
+  DidReceiveDeadNonceInterest (Ptr<Face> inFace,
+                               Ptr<const Interest> header,
+                               Ptr<const Packet> origPacket);
+
   /**
    * @brief An event that is fired every time a duplicated Interest is received
    *
@@ -22,6 +22,11 @@
 #ifndef NDNSIM_FW_TAG_H
 #define NDNSIM_FW_TAG_H
 
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <new>
+#include <stdint.h>
+
 namespace ns3 {
 namespace ndn {
 namespace fw {
@@ -29,6 +34,8 @@ namespace fw {
 /**
  * \ingroup ndn
  * \brief Abstract class for the forwarding strategy tag, which can be added to PIT entries
+ *
+ * Tag classes that are stored in TagSlots (see pit::Entry::GetOrCreateFwTag) should be default-constructible
  */
 class Tag
 {
@@ -36,6 +43,196 @@ public:
   virtual ~Tag () { };
 };
 
+/**
+ * \ingroup ndn
+ * \brief Storage of forwarding strategy tags, where each tag class has its own slot
+ *
+ * Each tag class gets a unique slot number when it is used for the first time (see GetSlot), so tag is
+ * accessed without any lookup or RTTI, and tag classes of different strategies and their extensions never
+ * share a slot.
+ *
+ * Slots are organized in blocks of SLOTS slots, and blocks are allocated when the first tag in them is
+ * created, so containers without tags take only a pointer.  Blocks are never moved, which allows tags not
+ * larger than INLINE_SIZE (e.g., a tag with a counter) to be stored inside the slot itself.  Bigger tags
+ * are allocated on heap.
+ */
+class TagSlots
+{
+public:
+  static const uint32_t SLOTS = 4;        ///< @brief number of slots in each block
+  static const uint32_t INLINE_SIZE = 16; ///< @brief maximum size of the tag that is stored inline
+
+  TagSlots ()
+    : m_blocks (0)
+  {
+  }
+
+  /**
+   * @brief Copy constructor (tags are not copied)
+   */
+  TagSlots (const TagSlots &)
+    : m_blocks (0)
+  {
+  }
+
+  ~TagSlots ()
+  {
+    Clear ();
+    while (m_blocks != 0)
+      {
+        Block *next = m_blocks->next;
+        delete m_blocks;
+        m_blocks = next;
+      }
+  }
+
+  /**
+   * @brief Get slot number of the tag class (assigned when the tag class is used for the first time)
+   */
+  template<class T>
+  static inline uint32_t
+  GetSlot ()
+  {
+    static const uint32_t slot = AllocateSlot ();
+    return slot;
+  }
+
+  /**
+   * @brief Get tag
+   * @returns 0 if there is no tag of type T
+   */
+  template<class T>
+  inline T *
+  Get () const
+  {
+    const Slot *slot = Find (GetSlot<T> ());
+    if (slot == 0 || slot->tag == 0)
+      return 0;
+
+    return static_cast<T*> (slot->tag);
+  }
+
+  /**
+   * @brief Get tag, creating a default-constructed one if there is no tag of type T yet
+   */
+  template<class T>
+  inline T &
+  GetOrCreate ()
+  {
+    Slot &slot = FindOrCreate (GetSlot<T> ());
+    if (slot.tag == 0)
+      {
+        if (sizeof (T) <= INLINE_SIZE &&
+            boost::alignment_of<T>::value <= boost::alignment_of<Slot>::value)
+          slot.tag = new (slot.storage.data) T ();
+        else
+          slot.tag = new T ();
+      }
+
+    return *static_cast<T*> (slot.tag);
+  }
+
+  /**
+   * @brief Remove tag of type T (if any)
+   */
+  template<class T>
+  inline void
+  Remove ()
+  {
+    Slot *slot = Find (GetSlot<T> ());
+    if (slot != 0)
+      Destroy (*slot);
+  }
+
+  /**
+   * @brief Remove all tags
+   */
+  inline void
+  Clear ()
+  {
+    for (Block *block = m_blocks; block != 0; block = block->next)
+      {
+        for (uint32_t slot = 0; slot < SLOTS; slot++)
+          Destroy (block->slots[slot]);
+      }
+  }
+
+private:
+  TagSlots &
+  operator = (const TagSlots &);
+
+  /**
+   * @brief Get the next unused slot number
+   */
+  static uint32_t
+  AllocateSlot ();
+
+  struct Slot
+  {
+    Slot () : tag (0) { }
+
+    Tag *tag; ///< @brief 0 if slot is empty, otherwise points either to storage or to heap
+    union
+    {
+      char data [INLINE_SIZE];
+      void *alignPointer;
+      double alignDouble;
+      uint64_t alignInteger;
+    } storage;
+  };
+
+  struct Block
+  {
+    Block () : next (0) { }
+
+    Slot slots [SLOTS];
+    Block *next; ///< @brief block with the following SLOTS slots (0 if not yet allocated)
+  };
+
+  inline Slot *
+  Find (uint32_t slot) const
+  {
+    Block *block = m_blocks;
+    for (; block != 0 && slot >= SLOTS; slot -= SLOTS)
+      block = block->next;
+
+    return (block != 0) ? &block->slots[slot] : 0;
+  }
+
+  inline Slot &
+  FindOrCreate (uint32_t slot)
+  {
+    Block **block = &m_blocks;
+    for (;; slot -= SLOTS)
+      {
+        if (*block == 0)
+          *block = new Block;
+
+        if (slot < SLOTS)
+          return (*block)->slots[slot];
+
+        block = &(*block)->next;
+      }
+  }
+
+  static inline void
+  Destroy (Slot &slot)
+  {
+    if (slot.tag == 0)
+      return;
+
+    const char *tag = reinterpret_cast<const char*> (slot.tag);
+    if (tag >= slot.storage.data && tag < slot.storage.data + INLINE_SIZE)
+      slot.tag->~Tag ();
+    else
+      delete slot.tag;
+    slot.tag = 0;
+  }
+
+private:
+  Block *m_blocks; ///< @brief 0 until the first tag is created
+};
+
 } // namespace fw
 } // namespace ndn
 } // namespace ns3
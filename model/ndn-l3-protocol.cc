@@ -36,6 +36,7 @@
 #include "ns3/ndn-pit.h"
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-content-object.h"
+#include "ns3/ndn-name.h"
 
 #include "ns3/ndn-face.h"
 #include "ns3/ndn-forwarding-strategy.h"
@@ -252,7 +253,6 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
 
   NS_LOG_LOGIC ("Packet from face " << *face << " received on node " <<  m_node->GetId ());
 
-  Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
   try
     {
       HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (p);
@@ -264,8 +264,9 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
             Ptr<Interest> header = Create<Interest> ();
 
             // Deserialization. Exception may be thrown
-            packet->RemoveHeader (*header);
-            NS_ASSERT_MSG (packet->GetSize () == 0, "Payload of Interests should be zero");
+            // Interests do not have payload, so the header is read directly from the original packet, without a copy
+            p->PeekHeader (*header);
+            NS_ASSERT_MSG (p->GetSize () == header->GetSerializedSize (), "Payload of Interests should be zero");
 
             m_forwardingStrategy->OnInterest (face, header, p/*original packet*/);
             // if (header->GetNack () > 0)
@@ -281,6 +282,7 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
 
             static ContentObjectTail contentObjectTrailer; //there is no data in this object
 
+            Ptr<Packet> packet = p->Copy (); // give upper layers a rw copy of the packet
             // Deserialization. Exception may be thrown
             packet->RemoveHeader (*header);
             packet->RemoveTrailer (contentObjectTrailer);
@@ -302,6 +304,11 @@ L3Protocol::Receive (const Ptr<Face> &face, const Ptr<const Packet> &p)
       NS_LOG_ERROR ("Unknown NDN header. Should not happen");
       return;
     }
+  catch (NameException)
+    {
+      NS_LOG_WARN ("Malformed name in packet from face " << *face << ", packet is dropped");
+      return;
+    }
 }
 
 
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+
+#include "ndn-name-dictionary.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.name.Dictionary");
+
+namespace ns3 {
+namespace ndn {
+namespace name {
+
+Dictionary &
+Dictionary::Get ()
+{
+  // never destroyed, so tries can release their components during static destruction
+  static Dictionary *dictionary = new Dictionary ();
+  return *dictionary;
+}
+
+uint32_t
+Dictionary::Acquire (const Component &component)
+{
+  ids_map::iterator item = m_ids.find (component, ComponentHash (), ComponentEqual ());
+  if (item != m_ids.end ())
+    {
+      m_records[item->second].m_references ++;
+      return item->second;
+    }
+
+  uint32_t id;
+  if (!m_free.empty ())
+    {
+      id = m_free.back ();
+      m_free.pop_back ();
+    }
+  else
+    {
+      NS_ASSERT_MSG (m_records.size () < NONE, "Too many interned components");
+
+      id = m_records.size ();
+      m_records.push_back (Record ());
+    }
+
+  item = m_ids.insert (std::make_pair (std::string (component), id)).first;
+  m_records[id].m_component = &item->first;
+  m_records[id].m_references = 1;
+
+  NS_LOG_DEBUG ("New component [" << component << "] id = " << id);
+  return id;
+}
+
+void
+Dictionary::AddRef (uint32_t id)
+{
+  NS_ASSERT_MSG (id < m_records.size () && m_records[id].m_component != 0, "Unknown component identifier");
+
+  m_records[id].m_references ++;
+}
+
+void
+Dictionary::Release (uint32_t id)
+{
+  NS_ASSERT_MSG (id < m_records.size () && m_records[id].m_references > 0, "Unknown component identifier");
+
+  Record &record = m_records[id];
+  record.m_references --;
+  if (record.m_references > 0)
+    return;
+
+  NS_LOG_DEBUG ("Free component [" << *record.m_component << "] id = " << id);
+
+  m_ids.erase (m_ids.find (*record.m_component)); // the key is referenced by the record
+  record.m_component = 0;
+  m_free.push_back (id);
+}
+
+size_t
+Dictionary::size () const
+{
+  return m_ids.size ();
+}
+
+} // namespace name
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+
+#ifndef _NDN_NAME_DICTIONARY_H_
+#define _NDN_NAME_DICTIONARY_H_
+
+#include "ndn-name.h"
+#include "ns3/assert.h"
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace name {
+
+/**
+ * \ingroup ndn
+ * \brief Dictionary of name components (interning), shared by all tries that use ndnSIM::interned_key_traits
+ *
+ * Maps bytes of each distinct component to a 32-bit identifier.  Identifiers are reference counted:
+ * an identifier is assigned when a component is stored for the first time (e.g., when a route is added
+ * to the interned FIB) and is freed for reuse when the last reference goes away, so the dictionary holds
+ * only components that are currently stored somewhere.  Lookups never add components to the dictionary.
+ */
+class Dictionary
+{
+public:
+  static const uint32_t NONE = 0xFFFFFFFF; ///< @brief Identifier that does not refer to any component
+
+  /**
+   * @brief Get the global instance of the dictionary
+   */
+  static Dictionary &
+  Get ();
+
+  /**
+   * @brief Get identifier of the component and add a reference to it (new identifier is assigned if component is not yet known)
+   */
+  uint32_t
+  Acquire (const Component &component);
+
+  /**
+   * @brief Add a reference to already known identifier
+   */
+  void
+  AddRef (uint32_t id);
+
+  /**
+   * @brief Remove a reference to the identifier (identifier is freed when there are no more references)
+   */
+  void
+  Release (uint32_t id);
+
+  /**
+   * @brief Get bytes of the component by its identifier
+   */
+  inline Component
+  Lookup (uint32_t id) const;
+
+  /**
+   * @brief Get number of components in the dictionary
+   */
+  size_t
+  size () const;
+
+private:
+  Dictionary () { }
+
+  struct ComponentHash
+  {
+    std::size_t
+    operator () (const Component &component) const
+    {
+      return boost::hash_range (component.begin (), component.end ());
+    }
+  };
+
+  struct ComponentEqual
+  {
+    bool
+    operator () (const Component &a, const Component &b) const
+    {
+      return a == b;
+    }
+  };
+
+  typedef boost::unordered_map<std::string, uint32_t, ComponentHash, ComponentEqual> ids_map;
+
+  struct Record
+  {
+    const std::string *m_component; ///< @brief bytes of the component (key of m_ids), 0 if identifier is free
+    uint32_t m_references;          ///< @brief number of references to the identifier
+  };
+
+  ids_map m_ids;                 ///< @brief component -> identifier
+  std::vector<Record> m_records; ///< @brief identifier -> component
+  std::vector<uint32_t> m_free;  ///< @brief identifiers that can be reused
+};
+
+/**
+ * \ingroup ndn
+ * \brief Reference to an interned name component (holds a reference to the identifier in Dictionary)
+ */
+class InternedComponent
+{
+public:
+  InternedComponent ()
+    : m_id (Dictionary::NONE)
+  {
+  }
+
+  explicit
+  InternedComponent (const Component &component)
+    : m_id (Dictionary::Get ().Acquire (component))
+  {
+  }
+
+  InternedComponent (const InternedComponent &other)
+    : m_id (other.m_id)
+  {
+    if (m_id != Dictionary::NONE)
+      Dictionary::Get ().AddRef (m_id);
+  }
+
+  ~InternedComponent ()
+  {
+    if (m_id != Dictionary::NONE)
+      Dictionary::Get ().Release (m_id);
+  }
+
+  InternedComponent &
+  operator= (const InternedComponent &other)
+  {
+    if (other.m_id != Dictionary::NONE)
+      Dictionary::Get ().AddRef (other.m_id);
+    if (m_id != Dictionary::NONE)
+      Dictionary::Get ().Release (m_id);
+    m_id = other.m_id;
+    return *this;
+  }
+
+  inline uint32_t
+  GetId () const
+  {
+    return m_id;
+  }
+
+  /**
+   * @brief Get bytes of the component (empty component if the object does not refer to any)
+   */
+  inline Component
+  GetComponent () const
+  {
+    return (m_id != Dictionary::NONE) ? Dictionary::Get ().Lookup (m_id) : Component ();
+  }
+
+  inline bool
+  operator== (const InternedComponent &other) const
+  {
+    return m_id == other.m_id;
+  }
+
+private:
+  uint32_t m_id;
+};
+
+inline std::ostream &
+operator << (std::ostream &os, const InternedComponent &component)
+{
+  os << component.GetComponent ();
+  return os;
+}
+
+Component
+Dictionary::Lookup (uint32_t id) const
+{
+  NS_ASSERT_MSG (id < m_records.size () && m_records[id].m_component != 0, "Unknown component identifier");
+
+  const std::string &component = *m_records[id].m_component;
+  return Component (component.data (), component.size ());
+}
+
+} // namespace name
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_NAME_DICTIONARY_H_
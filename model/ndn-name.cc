@@ -23,7 +23,10 @@
 #include <boost/foreach.hpp>
 #include "ns3/log.h"
 
+#include "../utils/trie/trie-allocator.h"
+
 #include <iostream>
+#include <new>
 
 using namespace std;
 
@@ -34,95 +37,362 @@ namespace ndn {
 
 ATTRIBUTE_HELPER_CPP (Name);
 
+namespace name {
+
+std::ostream &
+operator << (std::ostream &os, const Component &component)
+{
+  static const char hex[] = "0123456789ABCDEF";
+
+  for (const char *i = component.begin (); i != component.end (); i++)
+    {
+      uint8_t byte = static_cast<uint8_t> (*i);
+      if (byte <= 0x20 || byte >= 0x7F || byte == '/' || byte == '%')
+        {
+          // escape non-printable bytes (e.g., binary sequence numbers) and bytes that have special meaning in URI
+          os << '%' << hex [byte >> 4] << hex [byte & 0x0F];
+        }
+      else
+        os << *i;
+    }
+  return os;
+}
+
+} // namespace name
+
+const uint8_t Name::SEQ_NUM_MARKER;
+
+/**
+ * @brief Pool of name storage blocks
+ *
+ * Names are created and destroyed for every packet, so blocks are recycled instead of going to malloc.
+ * The pool is never destroyed, as names may be destroyed during static destruction
+ */
+static ndnSIM::slab_allocator &
+GetStoragePool ()
+{
+  static ndnSIM::slab_allocator *pool = new ndnSIM::slab_allocator ();
+  return *pool;
+}
+
+size_t
+Name::Storage::GetSize (uint32_t maxComponents, uint32_t capacity)
+{
+  return sizeof (Storage) + (maxComponents + 1) * (sizeof (std::size_t) + sizeof (uint32_t)) + capacity;
+}
+
+Name::Storage *
+Name::Storage::Allocate (uint32_t maxComponents, uint32_t capacity)
+{
+  void *block = GetStoragePool ().allocate (GetSize (maxComponents, capacity));
+
+  Storage *storage = new (block) Storage;
+  storage->m_count = 1;
+  storage->m_maxComponents = maxComponents;
+  storage->m_capacity = capacity;
+  storage->m_components = 0;
+  storage->m_hashes = 1;
+  storage->GetHashes () [0] = 0;
+  storage->GetOffsets () [0] = 0;
+
+  return storage;
+}
+
+void
+Name::Storage::Unref () const
+{
+  m_count--;
+  if (m_count == 0)
+    {
+      GetStoragePool ().deallocate (const_cast<Storage*> (this), GetSize (m_maxComponents, m_capacity));
+    }
+}
+
 Name::Name (/* root */)
+  : m_size (0)
 {
 }
 
 Name::Name (const std::list<boost::reference_wrapper<const std::string> > &components)
+  : m_size (0)
 {
+  uint32_t bytes = 0;
+  BOOST_FOREACH (const boost::reference_wrapper<const std::string> &component, components)
+    {
+      bytes += component.get ().size ();
+    }
+  PrepareAppend (components.size (), bytes);
+
   BOOST_FOREACH (const boost::reference_wrapper<const std::string> &component, components)
     {
-      Add (component.get ());
+      AppendUnchecked (component.get ().data (), component.get ().size ());
     }
 }
 
 Name::Name (const std::list<std::string> &components)
+  : m_size (0)
 {
+  uint32_t bytes = 0;
+  BOOST_FOREACH (const std::string &component, components)
+    {
+      bytes += component.size ();
+    }
+  PrepareAppend (components.size (), bytes);
+
   BOOST_FOREACH (const std::string &component, components)
     {
-      Add (component);
+      AppendUnchecked (component.data (), component.size ());
     }
 }
 
 Name::Name (const std::string &prefix)
+  : m_size (0)
 {
-  istringstream is (prefix);
-  is >> *this;
+  AppendUri (prefix.data (), prefix.size ());
 }
 
 Name::Name (const char *prefix)
+  : m_size (0)
 {
   NS_ASSERT (prefix != 0);
 
-  istringstream is (prefix);
-  is >> *this;
+  AppendUri (prefix, std::strlen (prefix));
+}
+
+Name::Name (const char *prefix, size_t length)
+  : m_size (0)
+{
+  NS_ASSERT (prefix != 0 || length == 0);
+
+  AppendUri (prefix, length);
 }
 
-const std::list<std::string> &
+static inline int
+HexValue (char c)
+{
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+static inline bool
+IsSpace (char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void
+Name::AppendUri (const char *uri, size_t length)
+{
+  const char *end = uri + length;
+
+  while (uri != end && IsSpace (*uri))
+    uri ++;
+
+  if (end - uri >= 4 && std::memcmp (uri, "ndn:", 4) == 0)
+    uri += 4;
+
+  if (uri == end)
+    return;
+
+  // decoded name cannot have more components than slashes plus one, and more bytes than the URI
+  uint32_t maxComponents = std::count (uri, end, '/') + 1;
+  PrepareAppend (maxComponents, end - uri);
+
+  uint32_t *offsets = m_storage->GetOffsets ();
+  char *data = m_storage->GetData ();
+  uint32_t start = offsets [m_size];
+  uint32_t position = start;
+
+  for (; uri != end; uri++)
+    {
+      char c = *uri;
+      if (c == '/')
+        {
+          if (position != start)
+            {
+              m_size ++;
+              offsets [m_size] = position;
+              start = position;
+            }
+        }
+      else if (IsSpace (c))
+        {
+          // whitespace is ignored (legacy behavior of operator>>)
+        }
+      else if (c == '%' && end - uri > 2 && HexValue (uri[1]) >= 0 && HexValue (uri[2]) >= 0)
+        {
+          data [position++] = static_cast<char> ((HexValue (uri[1]) << 4) | HexValue (uri[2]));
+          uri += 2;
+        }
+      else
+        {
+          data [position++] = c;
+        }
+    }
+
+  if (position != start)
+    {
+      m_size ++;
+      offsets [m_size] = position;
+    }
+  m_storage->m_components = m_size;
+}
+
+void
+Name::PrepareAppend (uint32_t components, uint32_t bytes)
+{
+  uint32_t usedBytes = (m_storage != 0) ? m_storage->GetOffsets () [m_size] : 0;
+
+  if (m_storage != 0 &&
+      m_storage->m_count == 1 &&
+      m_size + components <= m_storage->m_maxComponents &&
+      usedBytes + bytes <= m_storage->m_capacity)
+    {
+      // storage is not shared and has enough space. Drop components beyond the name (if any)
+      m_storage->m_components = m_size;
+      m_storage->m_hashes = std::min<std::size_t> (m_storage->m_hashes, m_size + 1);
+      return;
+    }
+
+  // leave some room to grow, so the following several appends will not need a new allocation
+  uint32_t maxComponents = m_size + components + (m_size + components) / 2 + 1;
+  uint32_t capacity = usedBytes + bytes + (usedBytes + bytes) / 2 + 8;
+
+  Storage *storage = Storage::Allocate (maxComponents, capacity);
+  if (m_size > 0)
+    {
+      std::memcpy (storage->GetOffsets (), m_storage->GetOffsets (), (m_size + 1) * sizeof (uint32_t));
+      std::memcpy (storage->GetData (), m_storage->GetData (), usedBytes);
+
+      storage->m_hashes = std::min<std::size_t> (m_storage->m_hashes, m_size + 1);
+      std::memcpy (storage->GetHashes (), m_storage->GetHashes (), storage->m_hashes * sizeof (std::size_t));
+    }
+  storage->m_components = m_size;
+
+  m_storage = Ptr<Storage> (storage, false);
+}
+
+void
+Name::CalculatePrefixHashes (size_t length) const
+{
+  std::size_t *hashes = m_storage->GetHashes ();
+
+  for (size_t i = m_storage->m_hashes; i <= length; i++)
+    {
+      hashes [i] = name::ExtendPrefixHash (hashes [i-1], get (i-1));
+    }
+  m_storage->m_hashes = length + 1;
+}
+
+Name &
+Name::Add (const std::string &value)
+{
+  PrepareAppend (1, value.size ());
+  AppendUnchecked (value.data (), value.size ());
+
+  return *this;
+}
+
+Name &
+Name::Add (const name::Component &value)
+{
+  if (m_storage != 0 &&
+      value.data () >= m_storage->GetData () &&
+      value.data () < m_storage->GetData () + m_storage->m_capacity)
+    {
+      // component references our own storage, which may be reallocated
+      return Add (std::string (value));
+    }
+
+  PrepareAppend (1, value.size ());
+  AppendUnchecked (value.data (), value.size ());
+
+  return *this;
+}
+
+Name &
+Name::AppendSeqNum (uint32_t seqNo)
+{
+  char component [5];
+  component [0] = static_cast<char> (SEQ_NUM_MARKER);
+  component [1] = static_cast<char> ((seqNo >> 24) & 0xFF);
+  component [2] = static_cast<char> ((seqNo >> 16) & 0xFF);
+  component [3] = static_cast<char> ((seqNo >> 8) & 0xFF);
+  component [4] = static_cast<char> (seqNo & 0xFF);
+
+  PrepareAppend (1, sizeof (component));
+  AppendUnchecked (component, sizeof (component));
+
+  return *this;
+}
+
+bool
+Name::HasSeqNum () const
+{
+  if (m_size == 0)
+    return false;
+
+  name::Component last = get (m_size - 1);
+  return last.size () == 5 && static_cast<uint8_t> (last.data () [0]) == SEQ_NUM_MARKER;
+}
+
+uint32_t
+Name::GetLastSeqNum () const
+{
+  NS_ASSERT_MSG (HasSeqNum (), "The last component of the name is not a sequence number");
+
+  const uint8_t *data = reinterpret_cast<const uint8_t*> (get (m_size - 1).data ());
+  return
+    (static_cast<uint32_t> (data [1]) << 24) |
+    (static_cast<uint32_t> (data [2]) << 16) |
+    (static_cast<uint32_t> (data [3]) << 8) |
+    static_cast<uint32_t> (data [4]);
+}
+
+std::list<std::string>
 Name::GetComponents () const
 {
-  return m_prefix;
+  return std::list<std::string> (begin (), end ());
 }
 
 std::string
 Name::GetLastComponent () const
 {
-  if (m_prefix.size () == 0)
+  if (m_size == 0)
     {
       return "";
     }
 
-  return m_prefix.back ();
+  return get (m_size - 1);
 }
 
-std::list<boost::reference_wrapper<const std::string> >
+std::list<std::string>
 Name::GetSubComponents (size_t num) const
 {
-  NS_ASSERT_MSG (0<=num && num<=m_prefix.size (), "Invalid number of subcomponents requested");
-
-  std::list<boost::reference_wrapper<const std::string> > subComponents;
-  std::list<std::string>::const_iterator component = m_prefix.begin();
-  for (size_t i=0; i<num; i++, component++)
-    {
-      subComponents.push_back (boost::ref (*component));
-    }
+  NS_ASSERT_MSG (0<=num && num<=m_size, "Invalid number of subcomponents requested");
 
-  return subComponents;
+  return std::list<std::string> (begin (), begin () + num);
 }
 
 Name
 Name::cut (size_t minusComponents) const
 {
-  Name retval;
-  std::list<std::string>::const_iterator component = m_prefix.begin ();
-  for (uint32_t i = 0; i < m_prefix.size () - minusComponents; i++, component++)
-    {
-      retval.Add (*component);
-    }
+  NS_ASSERT_MSG (minusComponents <= m_size, "Cannot cut more components than the name has");
 
+  Name retval (*this);
+  retval.m_size = m_size - minusComponents;
   return retval;
 }
 
 size_t
 Name::GetSerializedSize () const
 {
-  size_t nameSerializedSize = 2;
-
-  for (std::list<std::string>::const_iterator i = this->begin ();
-       i != this->end ();
-       i++)
+  size_t nameSerializedSize = 2 + 2 * m_size;
+  if (m_size > 0)
     {
-      nameSerializedSize += 2 + i->size ();
+      nameSerializedSize += m_storage->GetOffsets () [m_size];
     }
   NS_ASSERT_MSG (nameSerializedSize < 30000, "Name is too long (> 30kbytes)");
 
@@ -136,12 +406,12 @@ Name::Serialize (Buffer::Iterator start) const
 
   i.WriteU16 (static_cast<uint16_t> (this->GetSerializedSize ()-2));
 
-  for (std::list<std::string>::const_iterator item = this->begin ();
+  for (const_iterator item = this->begin ();
        item != this->end ();
        item++)
     {
       i.WriteU16 (static_cast<uint16_t> (item->size ()));
-      i.Write (reinterpret_cast<const uint8_t*> (item->c_str ()), item->size ());
+      i.Write (reinterpret_cast<const uint8_t*> (item->data ()), item->size ());
     }
 
   return i.GetDistanceFrom (start);
@@ -153,16 +423,29 @@ Name::Deserialize (Buffer::Iterator start)
   Buffer::Iterator i = start;
 
   uint16_t nameLength = i.ReadU16 ();
+
+  // each component takes at least 2 bytes (length field), so a single allocation is always enough
+  PrepareAppend (nameLength / 2, nameLength);
+
   while (nameLength > 0)
     {
+      if (nameLength < 2)
+        throw NameException ();
+
       uint16_t length = i.ReadU16 ();
+      if (2 + static_cast<uint32_t> (length) > nameLength)
+        throw NameException ();
+
       nameLength = nameLength - 2 - length;
 
-      uint8_t tmp[length];
-      i.Read (tmp, length);
+      uint32_t *offsets = m_storage->GetOffsets ();
+      uint32_t offset = offsets [m_size];
+      i.Read (reinterpret_cast<uint8_t*> (m_storage->GetData () + offset), length);
 
-      this->Add (string (reinterpret_cast<const char*> (tmp), length));
+      m_size ++;
+      offsets [m_size] = offset + length;
     }
+  m_storage->m_components = m_size;
 
   return i.GetDistanceFrom (start);
 }
@@ -170,11 +453,11 @@ Name::Deserialize (Buffer::Iterator start)
 void
 Name::Print (std::ostream &os) const
 {
-  for (const_iterator i=m_prefix.begin(); i!=m_prefix.end(); i++)
+  for (const_iterator i=begin(); i!=end(); i++)
     {
       os << "/" << *i;
     }
-  if (m_prefix.size ()==0) os << "/";
+  if (m_size==0) os << "/";
 }
 
 std::ostream &
@@ -184,26 +467,22 @@ operator << (std::ostream &os, const Name &components)
   return os;
 }
 
-std::istream &
-operator >> (std::istream &is, Name &components)
+std::ostream &
+operator << (std::ostream &os, const PrefixView &prefix)
 {
-  istream_iterator<char> eos; // end of stream
-
-  std::string component = "";
-  istream_iterator<char> it (is);
-  for (; it != eos; it++)
+  for (Name::const_iterator i = prefix.begin (); i != prefix.end (); i++)
     {
-      if (*it == '/')
-        {
-          if (component != "")
-              components.Add (component);
-          component = "";
-        }
-      else
-        component.push_back (*it);
+      os << "/" << *i;
     }
-  if (component != "")
-      components.Add (component);
+  if (prefix.size () == 0) os << "/";
+  return os;
+}
+
+std::istream &
+operator >> (std::istream &is, Name &components)
+{
+  std::string uri ((istreambuf_iterator<char> (is)), istreambuf_iterator<char> ());
+  components.AppendUri (uri.data (), uri.size ());
 
   is.clear ();
   // NS_LOG_ERROR (components << ", bad: " << is.bad () <<", fail: " << is.fail ());
@@ -29,14 +29,136 @@
 #include <string>
 #include <algorithm>
 #include <list>
+#include <cstring>
 #include "ns3/object.h"
 #include "ns3/buffer.h"
+#include "ns3/assert.h"
 
 #include <boost/ref.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/functional/hash.hpp>
 
 namespace ns3 {
 namespace ndn {
 
+namespace name {
+
+/**
+ * \ingroup ndn
+ * \brief Non-owning reference to a single component of the Name
+ *
+ * Component is valid only while the Name it was obtained from is alive and is not modified
+ */
+class Component
+{
+public:
+  /**
+   * \brief Default constructor (empty component)
+   */
+  Component ()
+    : m_data (0)
+    , m_size (0)
+  {
+  }
+
+  /**
+   * \brief Reference size bytes starting at data
+   */
+  Component (const char *data, size_t size)
+    : m_data (data)
+    , m_size (size)
+  {
+  }
+
+  /**
+   * \brief Reference bytes of the string (string should outlive the component)
+   */
+  Component (const std::string &value)
+    : m_data (value.data ())
+    , m_size (value.size ())
+  {
+  }
+
+  /**
+   * \brief Get pointer to the component bytes (not zero-terminated)
+   */
+  const char *
+  data () const { return m_data; }
+
+  /**
+   * \brief Get number of bytes in the component
+   */
+  size_t
+  size () const { return m_size; }
+
+  const char *
+  begin () const { return m_data; }
+
+  const char *
+  end () const { return m_data + m_size; }
+
+  /**
+   * \brief Create an owning copy of the component
+   */
+  operator std::string () const { return std::string (m_data, m_size); }
+
+  /**
+   * \brief Compare components the same way as std::string::compare does
+   */
+  int
+  compare (const Component &other) const
+  {
+    int result = std::memcmp (m_data, other.m_data, std::min (m_size, other.m_size));
+    if (result != 0)
+      return result;
+
+    return (m_size < other.m_size) ? -1 : ((m_size > other.m_size) ? 1 : 0);
+  }
+
+  friend bool
+  operator== (const Component &a, const Component &b)
+  {
+    return a.m_size == b.m_size && std::memcmp (a.m_data, b.m_data, a.m_size) == 0;
+  }
+
+  friend bool
+  operator!= (const Component &a, const Component &b)
+  {
+    return !(a == b);
+  }
+
+  friend bool
+  operator< (const Component &a, const Component &b)
+  {
+    return a.compare (b) < 0;
+  }
+
+private:
+  const char *m_data;
+  size_t m_size;
+};
+
+/**
+ * \brief Print out bytes of the component (percent-encoded where necessary, see Name::Print)
+ */
+std::ostream &
+operator << (std::ostream &os, const Component &component);
+
+/**
+ * @brief Calculate hash of the prefix extended with the component
+ *
+ * Name-like classes that calculate prefix hashes themselves should use this function,
+ * otherwise lookups in tries will not work
+ */
+inline std::size_t
+ExtendPrefixHash (std::size_t prefixHash, const Component &component)
+{
+  boost::hash_combine (prefixHash, boost::hash_range (component.begin (), component.end ()));
+  return prefixHash;
+}
+
+} // namespace name
+
 /**
  * \ingroup ndn
  * \brief Hierarchical NDN name
@@ -45,12 +167,15 @@ namespace ndn {
  * Each Component element contains a sequence of zero or more bytes.
  * There are no restrictions on what byte sequences may be used.
  * The Name element in an Interest is often referred to with the term name prefix or simply prefix.
+ *
+ * All components are kept in one contiguous buffer together with a table of component offsets,
+ * which is shared (copy-on-write) between all copies of the name, including prefixes created with cut ().
  */
 class Name : public SimpleRefCount<Name>
 {
 public:
-  typedef std::list<std::string>::iterator       iterator;
-  typedef std::list<std::string>::const_iterator const_iterator;
+  class const_iterator;
+  typedef const_iterator iterator;
 
   /**
    * \brief Constructor
@@ -74,18 +199,27 @@ public:
   
   /**
    * @brief Constructor
-   * Creates a prefix from the string (string is parsed using operator>>)
+   * Creates a prefix from the URI string (e.g., /first/second or ndn:/first/second).
+   * Percent-encoded bytes (e.g., %FE) are decoded, whitespace is ignored
    * @param[in] prefix A string representation of a prefix
    */
   Name (const std::string &prefix);
 
   /**
    * @brief Constructor
-   * Creates a prefix from the string (string is parsed using operator>>)
+   * Creates a prefix from the URI string (see Name (const std::string &))
    * @param[in] prefix A string representation of a prefix
    */
   Name (const char *prefix);
 
+  /**
+   * @brief Constructor
+   * Creates a prefix from the URI string of the specified length (see Name (const std::string &))
+   * @param[in] prefix A string representation of a prefix (does not need to be zero-terminated)
+   * @param[in] length Length of the string
+   */
+  Name (const char *prefix, size_t length);
+
   /**
    * \brief Generic Add method
    * Appends object of type T to the list of components
@@ -95,6 +229,18 @@ public:
   inline Name&
   Add (const T &value);
 
+  /**
+   * \brief Append string as a new component (no stream formatting involved)
+   */
+  Name&
+  Add (const std::string &value);
+
+  /**
+   * \brief Append a copy of the component (e.g., component of another name)
+   */
+  Name&
+  Add (const name::Component &value);
+
   /**
    * \brief Generic constructor operator
    * The object of type T will be appended to the list of components
@@ -103,11 +249,41 @@ public:
   inline Name&
   operator () (const T &value);
 
+  /**
+   * @brief Append sequence number as a binary component
+   *
+   * Component consists of the marker byte (SEQ_NUM_MARKER) followed by 4-byte sequence number
+   * in network byte order. No stream formatting is involved.
+   */
+  Name&
+  AppendSeqNum (uint32_t seqNo);
+
+  /**
+   * @brief Get sequence number from the last component (the component should be appended using AppendSeqNum,
+   *        names received from the network should be checked with HasSeqNum first)
+   */
+  uint32_t
+  GetLastSeqNum () const;
+
+  /**
+   * @brief Check if the last component is a sequence number (appended using AppendSeqNum)
+   */
+  bool
+  HasSeqNum () const;
+
+  /**
+   * @brief Marker byte of the sequence number component
+   */
+  static const uint8_t SEQ_NUM_MARKER = 0xFE;
+
   /**
    * \brief Get a name
    * Returns a list of components (strings)
+   *
+   * Note that the list is returned by value and is created on each call (earlier versions returned
+   * a reference to the internal list).  Use begin ()/end () or get () to access components without copying
    */
-  const std::list<std::string> &
+  std::list<std::string>
   GetComponents () const;
 
   /**
@@ -118,19 +294,50 @@ public:
 
   /**
    * \brief Get subcomponents of the name, starting with first component
+   *
+   * Note that the list contains copies of components (earlier versions returned references) and is
+   * created on each call.  Use PrefixView to walk prefixes without copying
    * @param[in] num Number of components to return. Valid value is in range [1, GetComponents ().size ()]
    */
-  std::list<boost::reference_wrapper<const std::string> >
+  std::list<std::string>
   GetSubComponents (size_t num) const;
 
+  /**
+   * @brief Get component by its index (no range checking)
+   */
+  inline name::Component
+  get (size_t index) const;
+
+  /**
+   * @brief Get hash of the prefix of the name that contains first length components
+   *
+   * Hashes are cumulative (hash of i-th prefix is calculated based on hash of (i-1)-th prefix
+   * and i-th component), calculated at most once and cached in the storage shared by all copies
+   * of the name. All lookup tables (PIT, FIB, CS) use this hash, so each component of the packet's
+   * name is hashed only once.
+   *
+   * @param length number of components in the prefix. Valid value is in range [0, size ()]
+   */
+  inline std::size_t
+  GetPrefixHash (size_t length) const;
+
   /**
    * @brief Get prefix of the name, containing less  minusComponents right components
+   *
+   * The returned name shares storage with this name, no components are copied.
+   * Use PrefixView if the prefix does not need to outlive the name
    */
   Name
   cut (size_t minusComponents) const;
 
   /**
    * \brief Print name
+   *
+   * Bytes of components that are not printable, whitespace, '/' and '%' are percent-encoded, so the
+   * output can be read back by operator>>.  Unlike earlier versions, which printed components as is,
+   * binary components are printed in escaped form: e.g., name with a sequence number added by
+   * AppendSeqNum (5) prints as /prefix/%FE%00%00%00%05
+   *
    * @param[in] os Stream to print
    */
   void Print (std::ostream &os) const;
@@ -151,6 +358,7 @@ public:
   /**
    * \brief Deserialize Name in ndnSIM packet encoding
    * @param[in] start buffer that contains serialized name
+   * @throws NameException if a component length does not fit into the encoded name length
    */
   uint32_t
   Deserialize (Buffer::Iterator start);
@@ -161,24 +369,12 @@ public:
   inline size_t
   size () const;
 
-  /**
-   * @brief Get read-write begin() iterator
-   */
-  inline iterator
-  begin ();
-
   /**
    * @brief Get read-only begin() iterator
    */
   inline const_iterator
   begin () const;
 
-  /**
-   * @brief Get read-write end() iterator
-   */
-  inline iterator
-  end ();
-
   /**
    * @brief Get read-only end() iterator
    */
@@ -200,18 +396,133 @@ public:
   typedef std::string partial_type;
 
 private:
-  std::list<std::string> m_prefix;                              ///< \brief a list of strings (components)
+  friend std::istream & operator >> (std::istream &is, Name &components);
+
+  /**
+   * @brief Reference-counted storage for name components
+   *
+   * Single memory block contains the header, table of cached prefix hashes, table of offsets
+   * (offset of i-th component, plus the end offset of the last component) and bytes of all components
+   */
+  class Storage
+  {
+  public:
+    static size_t
+    GetSize (uint32_t maxComponents, uint32_t capacity);
+
+    static Storage *
+    Allocate (uint32_t maxComponents, uint32_t capacity);
+
+    void
+    Ref () const { m_count++; }
+
+    void
+    Unref () const;
+
+    std::size_t *
+    GetHashes () const { return reinterpret_cast<std::size_t*> (const_cast<Storage*> (this + 1)); }
+
+    uint32_t *
+    GetOffsets () { return reinterpret_cast<uint32_t*> (GetHashes () + m_maxComponents + 1); }
+
+    const uint32_t *
+    GetOffsets () const { return reinterpret_cast<const uint32_t*> (GetHashes () + m_maxComponents + 1); }
+
+    char *
+    GetData () { return reinterpret_cast<char*> (GetOffsets () + m_maxComponents + 1); }
+
+    const char *
+    GetData () const { return reinterpret_cast<const char*> (GetOffsets () + m_maxComponents + 1); }
+
+    mutable uint32_t m_count; ///< @brief reference counter
+    uint32_t m_maxComponents; ///< @brief size of the offset table (without the end marker)
+    uint32_t m_capacity;      ///< @brief number of bytes reserved for components
+    uint32_t m_components;    ///< @brief number of components stored (could be more than in the name)
+    mutable std::size_t m_hashes; ///< @brief number of valid entries in the table of prefix hashes (at least one, for the empty prefix)
+  };
+
+  /**
+   * @brief Make sure storage is not shared and can accept additional components and bytes
+   */
+  void
+  PrepareAppend (uint32_t components, uint32_t bytes);
+
+  /**
+   * @brief Parse URI and append all its components (single pass, at most one allocation)
+   */
+  void
+  AppendUri (const char *uri, size_t length);
+
+  /**
+   * @brief Calculate and cache prefix hashes up to (and including) prefix of length components
+   */
+  void
+  CalculatePrefixHashes (size_t length) const;
+
+  /**
+   * @brief Append component without any checks (PrepareAppend should be called before)
+   */
+  inline void
+  AppendUnchecked (const char *data, uint32_t size);
+
+public:
+  /**
+   * @brief Random-access iterator over name components (dereferences to name::Component)
+   */
+  class const_iterator
+    : public boost::iterator_facade<const_iterator,
+                                    const name::Component,
+                                    boost::random_access_traversal_tag,
+                                    name::Component>
+  {
+  public:
+    const_iterator () : m_storage (0), m_index (0) { }
+    const_iterator (const Storage *storage, uint32_t index) : m_storage (storage), m_index (index) { }
+
+  private:
+    friend class boost::iterator_core_access;
+
+    name::Component
+    dereference () const
+    {
+      const uint32_t *offsets = m_storage->GetOffsets ();
+      return name::Component (m_storage->GetData () + offsets [m_index], offsets [m_index+1] - offsets [m_index]);
+    }
+
+    bool
+    equal (const const_iterator &other) const { return m_index == other.m_index; }
+
+    void
+    increment () { m_index ++; }
+
+    void
+    decrement () { m_index --; }
+
+    void
+    advance (difference_type n) { m_index += n; }
+
+    difference_type
+    distance_to (const const_iterator &other) const { return static_cast<difference_type> (other.m_index) - m_index; }
+
+  private:
+    const Storage *m_storage;
+    uint32_t m_index;
+  };
+
+private:
+  Ptr<Storage> m_storage; ///< @brief storage of components (shared copy-on-write)
+  uint32_t m_size;        ///< @brief number of components in the name (storage can contain more, if the name is a prefix)
 };
 
 /**
- * \brief Print out name components separated by slashes, e.g., /first/second/third
+ * \brief Print out name components separated by slashes, e.g., /first/second/third (see Name::Print)
  */
 std::ostream &
 operator << (std::ostream &os, const Name &components);
 
 /**
  * \brief Read components from input and add them to components. Will read input stream till eof
- * Substrings separated by slashes will become separate components
+ * Substrings separated by slashes will become separate components (see Name (const std::string &))
  */
 std::istream &
 operator >> (std::istream &is, Name &components);
@@ -222,13 +533,7 @@ operator >> (std::istream &is, Name &components);
 size_t
 Name::size () const
 {
-  return m_prefix.size ();
-}
-
-Name::iterator
-Name::begin ()
-{
-  return m_prefix.begin ();
+  return m_size;
 }
 
 /**
@@ -237,16 +542,7 @@ Name::begin ()
 Name::const_iterator
 Name::begin () const
 {
-  return m_prefix.begin ();
-}
-
-/**
- * @brief Get read-write end() iterator
- */
-Name::iterator
-Name::end ()
-{
-  return m_prefix.end ();
+  return const_iterator (PeekPointer (m_storage), 0);
 }
 
 /**
@@ -255,9 +551,39 @@ Name::end ()
 Name::const_iterator
 Name::end () const
 {
-  return m_prefix.end ();
+  return const_iterator (PeekPointer (m_storage), m_size);
+}
+
+name::Component
+Name::get (size_t index) const
+{
+  return *const_iterator (PeekPointer (m_storage), index);
 }
 
+std::size_t
+Name::GetPrefixHash (size_t length) const
+{
+  NS_ASSERT_MSG (length <= m_size, "Prefix cannot be longer than the name");
+  if (length == 0)
+    return 0;
+
+  if (m_storage->m_hashes <= length)
+    CalculatePrefixHashes (length);
+
+  return m_storage->GetHashes () [length];
+}
+
+void
+Name::AppendUnchecked (const char *data, uint32_t size)
+{
+  uint32_t *offsets = m_storage->GetOffsets ();
+  uint32_t offset = offsets [m_size];
+  std::memcpy (m_storage->GetData () + offset, data, size);
+
+  m_size ++;
+  offsets [m_size] = offset + size;
+  m_storage->m_components = m_size;
+}
 
 /**
  * \brief Generic constructor operator
@@ -281,9 +607,7 @@ Name::Add (const T &value)
 {
   std::ostringstream os;
   os << value;
-  m_prefix.push_back (os.str ());
-
-  return *this;
+  return Add (os.str ());
 }
 
 /**
@@ -292,10 +616,17 @@ Name::Add (const T &value)
 bool
 Name::operator== (const Name &prefix) const
 {
-  if (m_prefix.size () != prefix.m_prefix.size ())
+  if (m_size != prefix.m_size)
     return false;
 
-  return std::equal (m_prefix.begin (), m_prefix.end (), prefix.m_prefix.begin ());
+  if (m_size == 0 || m_storage == prefix.m_storage)
+    return true;
+
+  // components are stored back-to-back, so it is enough to compare offset tables and the data
+  const uint32_t *offsets = m_storage->GetOffsets ();
+  return
+    std::memcmp (offsets, prefix.m_storage->GetOffsets (), (m_size + 1) * sizeof (uint32_t)) == 0 &&
+    std::memcmp (m_storage->GetData (), prefix.m_storage->GetData (), offsets [m_size]) == 0;
 }
 
 /**
@@ -304,10 +635,95 @@ Name::operator== (const Name &prefix) const
 bool
 Name::operator< (const Name &prefix) const
 {
-  return std::lexicographical_compare (m_prefix.begin (), m_prefix.end (),
-                                       prefix.m_prefix.begin (), prefix.m_prefix.end ());
+  return std::lexicographical_compare (begin (), end (),
+                                       prefix.begin (), prefix.end ());
 }
 
+/**
+ * \ingroup ndn
+ * \brief Non-owning view of the prefix of the name (first length components)
+ *
+ * PrefixView can be used instead of GetSubComponents () or cut () to enumerate prefixes of the name
+ * without any memory allocations. FIB, PIT, CS and tries accept PrefixView directly.
+ *
+ * The view is valid only while the referenced name is alive and is not modified
+ */
+class PrefixView
+{
+public:
+  /**
+   * @brief Create view of the whole name
+   */
+  PrefixView (const Name &name)
+    : m_name (&name)
+    , m_length (name.size ())
+  {
+  }
+
+  /**
+   * @brief Create view of the prefix of the name
+   * @param length number of components in the prefix. Valid value is in range [0, name.size ()]
+   */
+  PrefixView (const Name &name, size_t length)
+    : m_name (&name)
+    , m_length (length)
+  {
+    NS_ASSERT_MSG (length <= name.size (), "Prefix cannot be longer than the name");
+  }
+
+  /**
+   * @brief Get number of components in the prefix
+   */
+  size_t
+  size () const { return m_length; }
+
+  /**
+   * @brief Get component by its index (no range checking)
+   */
+  name::Component
+  get (size_t index) const { return m_name->get (index); }
+
+  /**
+   * @brief Get hash of the prefix of the view (same as Name::GetPrefixHash)
+   */
+  std::size_t
+  GetPrefixHash (size_t length) const { return m_name->GetPrefixHash (length); }
+
+  Name::const_iterator
+  begin () const { return m_name->begin (); }
+
+  Name::const_iterator
+  end () const { return m_name->begin () + m_length; }
+
+  /**
+   * @brief Get the name, which the view references
+   */
+  const Name &
+  GetName () const { return *m_name; }
+
+  /**
+   * @brief Create a Name for the prefix (components are not copied, storage is shared with the referenced name)
+   */
+  Name
+  ToName () const { return m_name->cut (m_name->size () - m_length); }
+
+private:
+  const Name *m_name;
+  size_t m_length;
+};
+
+/**
+ * \brief Print out prefix components separated by slashes, e.g., /first/second
+ */
+std::ostream &
+operator << (std::ostream &os, const PrefixView &prefix);
+
+/**
+ * @ingroup ndn-exceptions
+ * @brief Class for Name parsing exception
+ */
+class NameException {};
+
 ATTRIBUTE_HELPER_HEADER (Name);
 
 // for backwards compatibility
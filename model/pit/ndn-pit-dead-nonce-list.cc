@@ -0,0 +1,109 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-pit-dead-nonce-list.h"
+
+#include "ns3/simulator.h"
+
+#include <boost/functional/hash.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+DeadNonceList::DeadNonceList ()
+{
+}
+
+void
+DeadNonceList::Add (std::size_t prefixHash, uint32_t nonce)
+{
+  if (m_lifetime.IsZero ())
+    return;
+
+  RemoveExpired ();
+
+  Record record;
+  record.m_key = MakeKey (prefixHash, nonce);
+  record.m_expireTime = Simulator::Now () + m_lifetime;
+
+  m_records.push_back (record);
+  m_keys.insert (record.m_key);
+}
+
+bool
+DeadNonceList::Has (std::size_t prefixHash, uint32_t nonce)
+{
+  if (m_records.empty ())
+    return false;
+
+  RemoveExpired ();
+  return m_keys.find (MakeKey (prefixHash, nonce)) != m_keys.end ();
+}
+
+void
+DeadNonceList::SetLifetime (const Time &lifetime)
+{
+  m_lifetime = lifetime;
+  if (m_lifetime.IsZero ())
+    clear ();
+}
+
+const Time &
+DeadNonceList::GetLifetime () const
+{
+  return m_lifetime;
+}
+
+size_t
+DeadNonceList::size () const
+{
+  return m_records.size ();
+}
+
+void
+DeadNonceList::clear ()
+{
+  m_records.clear ();
+  m_keys.clear ();
+}
+
+std::size_t
+DeadNonceList::MakeKey (std::size_t prefixHash, uint32_t nonce)
+{
+  boost::hash_combine (prefixHash, nonce);
+  return prefixHash;
+}
+
+void
+DeadNonceList::RemoveExpired ()
+{
+  Time now = Simulator::Now ();
+  while (!m_records.empty () && m_records.front ().m_expireTime <= now)
+    {
+      // erase only one of the equal keys, the same pair may have been added several times
+      m_keys.erase (m_keys.find (m_records.front ().m_key));
+      m_records.pop_front ();
+    }
+}
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,113 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_DEAD_NONCE_LIST_H_
+#define	_NDN_PIT_DEAD_NONCE_LIST_H_
+
+#include "ns3/nstime.h"
+
+#include <boost/unordered_set.hpp>
+
+#include <deque>
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+/**
+ * @ingroup ndn
+ * @brief List of nonces of the recently removed PIT entries
+ *
+ * The list allows to detect looping Interests after the PIT entry, which nonces they carry, has
+ * been already removed (e.g., immediately after it has been satisfied).  Instead of the full name,
+ * only hash of the name is stored together with the nonce, so a false positive is possible, but unlikely.
+ *
+ * Records are kept in FIFO order (for expiration) and in a hash set (for lookups), and are
+ * forgotten after the configured lifetime.
+ */
+class DeadNonceList
+{
+public:
+  DeadNonceList ();
+
+  /**
+   * @brief Add nonce of the removed PIT entry
+   * @param prefixHash hash of the PIT entry prefix (Name::GetPrefixHash of the whole name)
+   * @param nonce nonce, seen by the PIT entry
+   */
+  void
+  Add (std::size_t prefixHash, uint32_t nonce);
+
+  /**
+   * @brief Check if the nonce has been recently added for the prefix
+   *
+   * Expired records are removed during the call
+   */
+  bool
+  Has (std::size_t prefixHash, uint32_t nonce);
+
+  /**
+   * @brief Set time for which records are kept in the list (zero disables the list)
+   */
+  void
+  SetLifetime (const Time &lifetime);
+
+  /**
+   * @brief Get time for which records are kept in the list
+   */
+  const Time &
+  GetLifetime () const;
+
+  /**
+   * @brief Get number of records in the list (including those that expired, but have not been removed yet)
+   */
+  size_t
+  size () const;
+
+  /**
+   * @brief Remove all records
+   */
+  void
+  clear ();
+
+private:
+  static std::size_t
+  MakeKey (std::size_t prefixHash, uint32_t nonce);
+
+  void
+  RemoveExpired ();
+
+private:
+  struct Record
+  {
+    std::size_t m_key;
+    Time m_expireTime;
+  };
+
+  Time m_lifetime;
+  std::deque<Record> m_records;               ///< @brief records in the order of expiration
+  boost::unordered_multiset<std::size_t> m_keys; ///< @brief keys of all records in m_records
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_PIT_DEAD_NONCE_LIST_H_ */
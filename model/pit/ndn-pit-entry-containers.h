@@ -0,0 +1,376 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_ENTRY_CONTAINERS_H_
+#define	_NDN_PIT_ENTRY_CONTAINERS_H_
+
+#include "ns3/ptr.h"
+#include "ns3/ndn-face.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+/**
+ * @ingroup ndn
+ * @brief Container of per-face records of PIT entry (IncomingFace or OutgoingFace)
+ *
+ * Most of PIT entries have only a few incoming and outgoing faces, so records are stored in a small
+ * array inside the container, ordered by face (same order as std::set would give), and are looked up
+ * by linear scan.  Only when there are more than InlineCapacity records, they are moved to the heap.
+ *
+ * The interface is a subset of std::set interface, and similarly to std::set, records cannot be
+ * modified through iterators.  Unlike std::set, insert and erase invalidate iterators.
+ */
+template<class Record, uint32_t InlineCapacity>
+class FaceContainer
+{
+public:
+  typedef Record value_type;
+  typedef const Record &reference;
+  typedef const Record &const_reference;
+  typedef const Record *iterator;
+  typedef const Record *const_iterator;
+  typedef uint32_t size_type;
+
+  FaceContainer ()
+    : m_size (0)
+    , m_capacity (InlineCapacity)
+    , m_heap (0)
+  {
+  }
+
+  FaceContainer (const FaceContainer &other)
+    : m_size (0)
+    , m_capacity (InlineCapacity)
+    , m_heap (0)
+  {
+    *this = other;
+  }
+
+  ~FaceContainer ()
+  {
+    delete [] m_heap;
+  }
+
+  FaceContainer &
+  operator = (const FaceContainer &other)
+  {
+    if (this == &other)
+      return *this;
+
+    clear ();
+    reserve (other.m_size);
+    std::copy (other.begin (), other.end (), data ());
+    m_size = other.m_size;
+    return *this;
+  }
+
+  inline iterator
+  begin () const
+  {
+    return data ();
+  }
+
+  inline iterator
+  end () const
+  {
+    return data () + m_size;
+  }
+
+  inline size_type
+  size () const
+  {
+    return m_size;
+  }
+
+  inline bool
+  empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * @brief Find record for the face
+   * @returns end () if there is no record for the face
+   */
+  inline iterator
+  find (Ptr<Face> face) const
+  {
+    for (const Record *record = begin (); record != end (); record++)
+      {
+        if (record->m_face == face)
+          return record;
+      }
+    return end ();
+  }
+
+  /**
+   * @brief Insert record, unless there is already a record for the same face
+   * @returns iterator to the new or to the existing record and flag whether the record was inserted
+   */
+  std::pair<iterator, bool>
+  insert (const Record &record)
+  {
+    iterator existing = find (record.m_face);
+    if (existing != end ())
+      return std::make_pair (existing, false);
+
+    reserve (m_size + 1);
+    Record *records = data ();
+
+    uint32_t position = m_size;
+    while (position > 0 && *record.m_face < *records[position - 1].m_face)
+      {
+        records[position] = records[position - 1];
+        position--;
+      }
+    records[position] = record;
+    m_size++;
+
+    return std::make_pair (records + position, true);
+  }
+
+  void
+  erase (iterator position)
+  {
+    Record *records = data ();
+    std::copy (records + (position - records) + 1, records + m_size, records + (position - records));
+    m_size--;
+    records[m_size] = Record (); // release reference to the face
+  }
+
+  /**
+   * @brief Erase record for the face (if any)
+   * @returns number of erased records
+   */
+  size_type
+  erase (Ptr<Face> face)
+  {
+    iterator record = find (face);
+    if (record == end ())
+      return 0;
+
+    erase (record);
+    return 1;
+  }
+
+  /**
+   * @brief Remove all records (memory on the heap, if any, is kept for the later use)
+   */
+  void
+  clear ()
+  {
+    Record *records = data ();
+    std::fill (records, records + m_size, Record ());
+    m_size = 0;
+  }
+
+private:
+  inline Record *
+  data ()
+  {
+    return m_heap != 0 ? m_heap : m_inline;
+  }
+
+  inline const Record *
+  data () const
+  {
+    return m_heap != 0 ? m_heap : m_inline;
+  }
+
+  void
+  reserve (uint32_t size)
+  {
+    if (size <= m_capacity)
+      return;
+
+    uint32_t capacity = m_capacity;
+    while (capacity < size)
+      capacity *= 2;
+
+    Record *heap = new Record [capacity];
+    std::copy (begin (), end (), heap);
+
+    if (m_heap != 0)
+      delete [] m_heap;
+    else
+      std::fill (m_inline, m_inline + m_size, Record ());
+
+    m_heap = heap;
+    m_capacity = capacity;
+  }
+
+private:
+  uint32_t m_size;
+  uint32_t m_capacity;
+  Record *m_heap; ///< @brief 0, while records fit into m_inline
+  Record m_inline [InlineCapacity];
+};
+
+/**
+ * @ingroup ndn
+ * @brief Set of nonces seen by PIT entry
+ *
+ * First Capacity nonces are stored inside the container and are looked up by linear scan.  When more
+ * nonces are seen (e.g., many retransmissions or looping Interests), they are moved to the heap, so
+ * nonces are never forgotten while PIT entry exists.  Nonces are kept in the order they were added.
+ */
+template<uint32_t Capacity>
+class NonceContainer
+{
+public:
+  typedef uint32_t value_type;
+  typedef const uint32_t *iterator;
+  typedef const uint32_t *const_iterator;
+  typedef uint32_t size_type;
+
+  NonceContainer ()
+    : m_size (0)
+    , m_capacity (Capacity)
+    , m_heap (0)
+  {
+  }
+
+  NonceContainer (const NonceContainer &other)
+    : m_size (0)
+    , m_capacity (Capacity)
+    , m_heap (0)
+  {
+    *this = other;
+  }
+
+  ~NonceContainer ()
+  {
+    delete [] m_heap;
+  }
+
+  NonceContainer &
+  operator = (const NonceContainer &other)
+  {
+    if (this == &other)
+      return *this;
+
+    clear ();
+    reserve (other.m_size);
+    std::copy (other.begin (), other.end (), data ());
+    m_size = other.m_size;
+    return *this;
+  }
+
+  inline iterator
+  begin () const
+  {
+    return data ();
+  }
+
+  inline iterator
+  end () const
+  {
+    return data () + m_size;
+  }
+
+  inline size_type
+  size () const
+  {
+    return m_size;
+  }
+
+  inline bool
+  empty () const
+  {
+    return m_size == 0;
+  }
+
+  inline iterator
+  find (uint32_t nonce) const
+  {
+    return std::find (begin (), end (), nonce);
+  }
+
+  /**
+   * @brief Add nonce (no-op if the nonce is already there)
+   */
+  inline void
+  insert (uint32_t nonce)
+  {
+    if (find (nonce) != end ())
+      return;
+
+    reserve (m_size + 1);
+    data ()[m_size] = nonce;
+    m_size++;
+  }
+
+  /**
+   * @brief Remove all nonces (memory on the heap, if any, is kept for the later use)
+   */
+  inline void
+  clear ()
+  {
+    m_size = 0;
+  }
+
+private:
+  inline uint32_t *
+  data ()
+  {
+    return m_heap != 0 ? m_heap : m_inline;
+  }
+
+  inline const uint32_t *
+  data () const
+  {
+    return m_heap != 0 ? m_heap : m_inline;
+  }
+
+  void
+  reserve (uint32_t size)
+  {
+    if (size <= m_capacity)
+      return;
+
+    uint32_t capacity = m_capacity;
+    while (capacity < size)
+      capacity *= 2;
+
+    uint32_t *heap = new uint32_t [capacity];
+    std::copy (begin (), end (), heap);
+    delete [] m_heap;
+
+    m_heap = heap;
+    m_capacity = capacity;
+  }
+
+private:
+  uint32_t m_size;
+  uint32_t m_capacity;
+  uint32_t *m_heap; ///< @brief 0, while nonces fit into m_inline
+  uint32_t m_inline [Capacity];
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif	// _NDN_PIT_ENTRY_CONTAINERS_H_
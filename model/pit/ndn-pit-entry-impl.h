@@ -28,8 +28,19 @@ class Pit;
 
 namespace pit {
 
+/**
+ * @brief PIT entry of the trie-based PIT
+ *
+ * If PIT is configured to keep lean entries (see PitImpl attribute LeanEntries), the entry releases
+ * the Interest and the prefix as soon as it is placed in the trie, and the prefix is restored from
+ * the trie node on demand (see RestorePrefix)
+ *
+ * Entries are allocated from a pool (see ndnSIM::pool_allocated), so PIT in a steady state does not
+ * call malloc for entries
+ */
 template<class Pit>
-class EntryImpl : public Entry
+class EntryImpl : public Entry,
+                  public ndnSIM::pool_allocated< EntryImpl<Pit> >
 {
 public:
   typedef Entry base_type;
@@ -44,58 +55,99 @@ public:
   : Entry (pit, header, fibEntry)
   , item_ (0)
   {
-    CONTAINER.i_time.insert (*this);
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.m_timers.Insert (*this);
+    CONTAINER.ScheduleCleaning (this->GetExpireTime ());
   }
   
   virtual ~EntryImpl ()
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
-    
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.m_timers.Erase (*this);
+    // no need to reschedule cleaning, it will simply find nothing to do
   }
 
   virtual void
   UpdateLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+    CONTAINER.m_timers.Erase (*this);
     super::UpdateLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
+    CONTAINER.m_timers.Insert (*this);
 
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.ScheduleCleaning (this->GetExpireTime ());
   }
 
   virtual void
   OffsetLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
+    CONTAINER.m_timers.Erase (*this);
     super::OffsetLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
+    CONTAINER.m_timers.Insert (*this);
 
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.ScheduleCleaning (this->GetExpireTime ());
   }
   
   // to make sure policies work
   void
-  SetTrie (typename Pit::super::iterator item) { item_ = item; }
+  SetTrie (typename Pit::super::iterator item)
+  {
+    item_ = item;
+  }
+
+  /**
+   * @brief Release the Interest and the prefix (should be called after the entry is placed in the trie)
+   */
+  void
+  MakeLean ()
+  {
+    NS_ASSERT_MSG (item_ != 0, "Entry should be in the trie");
+    super::DropInterest ();
+  }
+
+  /**
+   * @brief Called just before the entry is removed from the trie (see EntryPayloadTraits)
+   *
+   * Releases the charge of the entry to its incoming face.  Prefix of the lean entry is restored,
+   * while the trie node still exists, so the entry remains valid for anybody who still references it
+   */
+  void
+  Detach ()
+  {
+    CONTAINER.ReleaseFaceEntry (*this);
+
+    if (item_ == 0)
+      return;
+
+    super::GetPrefix (); // no-op, unless the prefix has been dropped
+    item_ = 0;
+  }
 
   typename Pit::super::iterator to_iterator () { return item_; }
   typename Pit::super::const_iterator to_iterator () const { return item_; }
 
 public:
-  boost::intrusive::set_member_hook<> time_hook_;
-  
+  TimerWheelHook time_hook_;
+
+protected:
+  virtual Name
+  RestorePrefix () const
+  {
+    NS_ASSERT_MSG (item_ != 0, "Lean entry should be in the trie");
+    return item_->full_key ();
+  }
+
 private:
   typename Pit::super::iterator item_;
 };
 
-template<class T>
-struct TimestampIndex
+/**
+ * @brief Payload traits of the trie-based PIT, which detach entries before they are erased from the trie
+ */
+template<class Payload>
+struct EntryPayloadTraits : public ndnSIM::smart_pointer_payload_traits<Payload>
 {
-  bool
-  operator () (const T &a, const T &b) const
+  static void
+  on_erase (const Ptr<Payload> &entry)
   {
-    return a.GetExpireTime () < b.GetExpireTime ();
+    entry->Detach ();
   }
 };
 
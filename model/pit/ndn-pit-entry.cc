@@ -43,9 +43,17 @@ Entry::Entry (Pit &container,
               Ptr<const Interest> header,
               Ptr<fib::Entry> fibEntry)
   : m_container (container)
+  , m_prefix (header->GetName ())
   , m_interest (header)
   , m_fibEntry (fibEntry)
   , m_maxRetxCount (0)
+  , m_interestLifetime (header->GetInterestLifetime ())
+  , m_nonce (header->GetNonce ())
+  , m_interestSize (header->GetSerializedSize ())
+  , m_faceId (NO_FACE)
+  , m_scope (header->GetScope ())
+  , m_nackType (header->GetNack ())
+  , m_prefixDropped (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -56,9 +64,32 @@ Entry::Entry (Pit &container,
                    Seconds (1.0)));
 }
 
+Entry::Entry (const Entry &other)
+  : SimpleRefCount<Entry> (other)
+  , m_container (other.m_container)
+  , m_prefix (other.GetPrefix ())
+  , m_interest (other.m_interest)
+  , m_fibEntry (other.m_fibEntry)
+  , m_seenNonces (other.m_seenNonces)
+  , m_incoming (other.m_incoming)
+  , m_outgoing (other.m_outgoing)
+  , m_expireTime (other.m_expireTime)
+  , m_lastRetransmission (other.m_lastRetransmission)
+  , m_maxRetxCount (other.m_maxRetxCount)
+  , m_fwTags (other.m_fwTags)
+  , m_interestLifetime (other.m_interestLifetime)
+  , m_nonce (other.m_nonce)
+  , m_interestSize (other.m_interestSize)
+  , m_faceId (NO_FACE)
+  , m_scope (other.m_scope)
+  , m_nackType (other.m_nackType)
+  , m_prefixDropped (false)
+{
+}
+
 Entry::~Entry ()
 {
-  NS_LOG_FUNCTION (GetPrefix ());
+  NS_LOG_FUNCTION (this);
 }
 
 void
@@ -87,12 +118,6 @@ Entry::OffsetLifetime (const Time &offsetTime)
 }
 
 
-const Name &
-Entry::GetPrefix () const
-{
-  return m_interest->GetName ();
-}
-
 const Time &
 Entry::GetExpireTime () const
 {
@@ -105,6 +130,12 @@ Entry::IsNonceSeen (uint32_t nonce) const
   return m_seenNonces.find (nonce) != m_seenNonces.end ();
 }
 
+const Entry::nonce_container &
+Entry::GetSeenNonces () const
+{
+  return m_seenNonces;
+}
+
 void
 Entry::AddSeenNonce (uint32_t nonce)
 {
@@ -264,10 +295,70 @@ Entry::GetMaxRetxCount () const
   return m_maxRetxCount;
 }
 
+const Time &
+Entry::GetInterestLifetime () const
+{
+  return m_interestLifetime;
+}
+
+int8_t
+Entry::GetScope () const
+{
+  return m_scope;
+}
+
+uint8_t
+Entry::GetNack () const
+{
+  return m_nackType;
+}
+
+uint32_t
+Entry::GetNonce () const
+{
+  return m_nonce;
+}
+
+uint32_t
+Entry::GetInterestSize () const
+{
+  return m_interestSize;
+}
+
 Ptr<const Interest>
 Entry::GetInterest () const
 {
-  return m_interest;
+  if (m_interest != 0)
+    return m_interest;
+
+  Ptr<Interest> interest = Create<Interest> ();
+  interest->SetName (GetPrefix ());
+  interest->SetScope (m_scope);
+  interest->SetInterestLifetime (m_interestLifetime);
+  interest->SetNonce (m_nonce);
+  interest->SetNack (m_nackType);
+  return interest;
+}
+
+bool
+Entry::IsLean () const
+{
+  return m_interest == 0;
+}
+
+void
+Entry::DropInterest ()
+{
+  m_interest = 0;
+  m_prefix = Name ();
+  m_prefixDropped = true;
+}
+
+Name
+Entry::RestorePrefix () const
+{
+  NS_FATAL_ERROR ("This PIT entry cannot restore its prefix");
+  return Name ();
 }
 
 std::ostream& operator<< (std::ostream& os, const Entry &entry)
@@ -23,11 +23,15 @@
 
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
 
+#include "ns3/ndn-name.h"
 #include "ns3/ndn-fib.h"
+#include "ns3/ndn-fw-tag.h"
 
 #include "ns3/ndn-pit-entry-incoming-face.h"
 #include "ns3/ndn-pit-entry-outgoing-face.h"
+#include "ns3/ndn-pit-entry-containers.h"
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/tag.hpp>
@@ -36,16 +40,15 @@
 // #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 // #include <boost/multi_index/mem_fun.hpp>
-#include <set>
 #include <boost/shared_ptr.hpp>
 
+#include <list>
+
 namespace ns3 {
 namespace ndn {
 
 class Pit;
 
-namespace fw { class Tag; }
-
 namespace pit {
 
 /// @cond include_hidden
@@ -87,18 +90,22 @@ class i_retx {};
  * \brief structure for PIT entry
  *
  * All set-methods are virtual, in case index rearrangement is necessary in the derived classes
+ *
+ * Besides the Interest that created the entry, the entry keeps copies of the fields that are needed by
+ * the forwarding strategies (GetInterestLifetime, GetScope, GetNack, GetNonce).  PIT implementations may
+ * release the Interest and the name of the entry to save memory (lean entries, see DropInterest).  The
+ * prefix of a lean entry is restored from the data structure, in which the entry is placed (see RestorePrefix)
  */
 class Entry : public SimpleRefCount<Entry>
 {
 public:
-  typedef std::set< IncomingFace > in_container; ///< @brief incoming faces container type
-  typedef in_container::iterator in_iterator;                ///< @brief iterator to incoming faces
+  typedef FaceContainer< IncomingFace, 2 > in_container; ///< @brief incoming faces container type (two records are stored inline)
+  typedef in_container::iterator in_iterator;            ///< @brief iterator to incoming faces
 
-  // typedef OutgoingFaceContainer::type out_container; ///< @brief outgoing faces container type
-  typedef std::set< OutgoingFace > out_container; ///< @brief outgoing faces container type
-  typedef out_container::iterator out_iterator;              ///< @brief iterator to outgoing faces
+  typedef FaceContainer< OutgoingFace, 2 > out_container; ///< @brief outgoing faces container type (two records are stored inline)
+  typedef out_container::iterator out_iterator;           ///< @brief iterator to outgoing faces
 
-  typedef std::set< uint32_t > nonce_container;  ///< @brief nonce container type
+  typedef NonceContainer< 4 > nonce_container;  ///< @brief nonce container type (four nonces are stored inline)
 
   /**
    * \brief PIT entry constructor
@@ -108,6 +115,11 @@ public:
    */
   Entry (Pit &container, Ptr<const Interest> header, Ptr<fib::Entry> fibEntry);
 
+  /**
+   * @brief Copy constructor (the copy is not charged to any face, see Pit::Create)
+   */
+  Entry (const Entry &other);
+
   /**
    * @brief Virtual destructor
    */
@@ -136,8 +148,10 @@ public:
 
   /**
    * @brief Get prefix of the PIT entry
+   *
+   * Prefix of a lean entry is restored on the first call and is kept in the entry afterwards
    */
-  const Name &
+  inline const Name &
   GetPrefix () const;
 
   /**
@@ -156,12 +170,16 @@ public:
   bool
   IsNonceSeen (uint32_t nonce) const;
 
+  /**
+   * @brief Get nonces that were seen for the prefix
+   */
+  const nonce_container &
+  GetSeenNonces () const;
+
   /**
    * @brief Add `nonce` to the list of seen nonces
    *
    * @param nonce nonce to add to the list of seen nonces
-   *
-   * All nonces are stored for the lifetime of the PIT entry
    */
   virtual void
   AddSeenNonce (uint32_t nonce);
@@ -170,7 +188,7 @@ public:
    * @brief Add `face` to the list of incoming faces
    *
    * @param face Face to add to the list of incoming faces
-   * @returns iterator to the added entry
+   * @returns iterator to the added entry (valid until the container is modified again)
    */
   virtual in_iterator
   AddIncoming (Ptr<Face> face);
@@ -191,7 +209,7 @@ public:
    * @brief Add `face` to the list of outgoing faces
    *
    * @param face Face to add to the list of outgoing faces
-   * @returns iterator to the added entry
+   * @returns iterator to the added entry (valid until the container is modified again)
    */
   virtual out_iterator
   AddOutgoing (Ptr<Face> face);
@@ -270,40 +288,127 @@ public:
 
   /**
    * @brief Add new forwarding strategy tag
+   *
+   * Tags added this way are kept in a list and are looked up with dynamic_pointer_cast (see GetFwTag).
+   * New code should use GetOrCreateFwTag and PeekFwTag, which do not need any lookup
    */
   inline void
   AddFwTag (boost::shared_ptr< fw::Tag > tag);
 
   /**
-   * @brief Get forwarding strategy tag (tag is not removed)
+   * @brief Get forwarding strategy tag, added with AddFwTag (tag is not removed)
    */
   template<class T>
   inline boost::shared_ptr< T >
   GetFwTag ();
 
   /**
-   * @brief Remove the forwarding strategy tag
+   * @brief Get forwarding strategy tag, created with GetOrCreateFwTag
+   * @returns 0 if tag of type T has not been created
+   */
+  template<class T>
+  inline T *
+  PeekFwTag ();
+
+  /**
+   * @brief Get forwarding strategy tag, creating it if necessary
+   * @see fw::TagSlots
+   */
+  template<class T>
+  inline T &
+  GetOrCreateFwTag ();
+
+  /**
+   * @brief Remove the forwarding strategy tag (both created with GetOrCreateFwTag and added with AddFwTag)
    */
   template<class T>
   inline void
   RemoveFwTag ();
 
+  /**
+   * @brief Get lifetime of the first Interest
+   */
+  const Time &
+  GetInterestLifetime () const;
+
+  /**
+   * @brief Get scope of the first Interest
+   */
+  int8_t
+  GetScope () const;
+
+  /**
+   * @brief Get NACK type of the first Interest
+   */
+  uint8_t
+  GetNack () const;
+
+  /**
+   * @brief Get nonce of the first Interest
+   */
+  uint32_t
+  GetNonce () const;
+
+  /**
+   * @brief Get serialized size of the first Interest (e.g., to account PIT memory usage)
+   */
+  uint32_t
+  GetInterestSize () const;
+
   /**
    * @brief Get Interest (if several interests are received, then nonce is from the first Interest)
+   *
+   * Lean entries do not keep the Interest, and a new one is created from the prefix and fields of the
+   * first Interest (GetInterestLifetime, GetScope, GetNack, GetNonce) on every call
    */
   Ptr<const Interest>
   GetInterest () const;
 
+  /**
+   * @brief Check if the entry has released the Interest that created it (see DropInterest)
+   */
+  bool
+  IsLean () const;
+
+protected:
+  /**
+   * @brief Release the Interest and the name of the entry (make entry lean)
+   *
+   * Should be called only by PIT implementations that can restore the prefix (see RestorePrefix)
+   */
+  void
+  DropInterest ();
+
+  /**
+   * @brief Restore prefix of the lean entry from the data structure, in which the entry is placed
+   *
+   * Default implementation fails, because the plain entry cannot restore the prefix
+   */
+  virtual Name
+  RestorePrefix () const;
+
 private:
   friend std::ostream& operator<< (std::ostream& os, const Entry &entry);
+  friend class ndn::Pit; // to charge entry to the face
+
+  static const uint32_t NO_FACE = 0xFFFFFFFF; ///< @brief value of m_faceId, if entry is not charged to any face
+
+  /**
+   * @brief Tags added with AddFwTag (kept in a slot, so entries without such tags do not pay for the list)
+   */
+  struct SharedFwTags : public fw::Tag
+  {
+    std::list< boost::shared_ptr<fw::Tag> > m_tags;
+  };
 
 protected:
   Pit &m_container; ///< @brief Reference to the container (to rearrange indexes, if necessary)
 
-  Ptr<const Interest> m_interest; ///< \brief Interest of the PIT entry (if several interests are received, then nonce is from the first Interest)
-  Ptr<fib::Entry> m_fibEntry;     ///< \brief FIB entry related to this prefix
+  mutable Name m_prefix;      ///< \brief Prefix of the PIT entry (empty, while m_prefixDropped is set)
+  Ptr<const Interest> m_interest; ///< \brief Interest of the PIT entry (0 for lean entries, see DropInterest)
+  Ptr<fib::Entry> m_fibEntry; ///< \brief FIB entry related to this prefix
 
-  nonce_container m_seenNonces;  ///< \brief map of nonces that were seen for this prefix
+  nonce_container m_seenNonces;  ///< \brief nonces that were seen for this prefix
   in_container  m_incoming;      ///< \brief container for incoming interests
   out_container m_outgoing;      ///< \brief container for outgoing interests
 
@@ -312,7 +417,15 @@ protected:
   Time m_lastRetransmission; ///< @brief Last time when number of retransmissions were increased
   uint32_t m_maxRetxCount;   ///< @brief Maximum allowed number of retransmissions via outgoing faces
 
-  std::list< boost::shared_ptr<fw::Tag> > m_fwTags; ///< @brief Forwarding strategy tags
+  fw::TagSlots m_fwTags; ///< @brief Forwarding strategy tags
+
+  Time m_interestLifetime; ///< @brief InterestLifetime of the first Interest
+  uint32_t m_nonce;        ///< @brief Nonce of the first Interest
+  uint32_t m_interestSize; ///< @brief Serialized size of the first Interest
+  uint32_t m_faceId;       ///< @brief Id of the face, to which entry is charged (see Pit::Create)
+  int8_t m_scope;          ///< @brief Scope of the first Interest
+  uint8_t m_nackType;      ///< @brief NACK type of the first Interest
+  mutable bool m_prefixDropped; ///< @brief Prefix has been released and has not been restored yet (see GetPrefix)
 };
 
 struct EntryIsNotEmpty
@@ -326,21 +439,33 @@ struct EntryIsNotEmpty
 
 std::ostream& operator<< (std::ostream& os, const Entry &entry);
 
+const Name &
+Entry::GetPrefix () const
+{
+  if (m_prefixDropped)
+    {
+      m_prefix = RestorePrefix ();
+      m_prefixDropped = false;
+    }
+  return m_prefix;
+}
+
 inline void
 Entry::AddFwTag (boost::shared_ptr< fw::Tag > tag)
 {
-  m_fwTags.push_back (tag);
+  m_fwTags.GetOrCreate<SharedFwTags> ().m_tags.push_back (tag);
 }
 
-/**
- * @brief Get and remove forwarding strategy tag
- */
 template<class T>
 inline boost::shared_ptr< T >
 Entry::GetFwTag ()
 {
-  for (std::list< boost::shared_ptr<fw::Tag> >::iterator item = m_fwTags.begin ();
-       item != m_fwTags.end ();
+  SharedFwTags *tags = m_fwTags.Get<SharedFwTags> ();
+  if (tags == 0)
+    return boost::shared_ptr< T > ();
+
+  for (std::list< boost::shared_ptr<fw::Tag> >::iterator item = tags->m_tags.begin ();
+       item != tags->m_tags.end ();
        item ++)
     {
       boost::shared_ptr< T > retPtr = boost::dynamic_pointer_cast<T> (*item);
@@ -353,39 +478,38 @@ Entry::GetFwTag ()
   return boost::shared_ptr< T > ();
 }
 
-// /**
-//  * @brief Peek the forwarding strategy tag
-//  */
-// template<class T>
-// inline boost::shared_ptr< const T >
-// Entry::PeekFwTag () const
-// {
-//   for (std::list< boost::shared_ptr<fw::Tag> >::const_iterator item = m_fwTags.begin ();
-//        item != m_fwTags.end ();
-//        item ++)
-//     {
-//       boost::shared_ptr< const T > retPtr = boost::dynamic_pointer_cast<const T> (*item);
-//       if (retPtr != 0)
-//         {
-//           return retPtr;
-//         }
-//     }
-
-//   return 0;
-// }
+template<class T>
+inline T *
+Entry::PeekFwTag ()
+{
+  return m_fwTags.Get<T> ();
+}
+
+template<class T>
+inline T &
+Entry::GetOrCreateFwTag ()
+{
+  return m_fwTags.GetOrCreate<T> ();
+}
 
 template<class T>
 inline void
 Entry::RemoveFwTag ()
 {
-  for (std::list< boost::shared_ptr<fw::Tag> >::iterator item = m_fwTags.begin ();
-       item != m_fwTags.end ();
+  m_fwTags.Remove<T> ();
+
+  SharedFwTags *tags = m_fwTags.Get<SharedFwTags> ();
+  if (tags == 0)
+    return;
+
+  for (std::list< boost::shared_ptr<fw::Tag> >::iterator item = tags->m_tags.begin ();
+       item != tags->m_tags.end ();
        item ++)
     {
       boost::shared_ptr< T > retPtr = boost::dynamic_pointer_cast< T > (*item);
       if (retPtr != boost::shared_ptr< T > ())
         {
-          m_fwTags.erase (item);
+          tags->m_tags.erase (item);
           return;
         }
     }
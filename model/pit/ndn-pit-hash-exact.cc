@@ -0,0 +1,488 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-pit-hash-exact.h"
+
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+#include "ns3/ndn-forwarding-strategy.h"
+
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <boost/ref.hpp>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.pit.HashExact");
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+NS_OBJECT_ENSURE_REGISTERED (HashExact);
+
+static const uint32_t INITIAL_TABLE_SIZE = 64;
+
+TypeId
+HashExact::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::pit::HashExact")
+    .SetGroupName ("Ndn")
+    .SetParent<Pit> ()
+    .AddConstructor<HashExact> ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in PIT. If 0, limit is not enforced",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&HashExact::m_maxSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("CurrentSize", "Get current number of entries in PIT",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&HashExact::m_size),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("TimerGranularity",
+                   "Granularity of PIT entry expiration. Expired entries are removed in batches, at most this time late",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&HashExact::GetTimerGranularity,
+                                     &HashExact::SetTimerGranularity),
+                   MakeTimeChecker ())
+    ;
+
+  return tid;
+}
+
+HashExact::HashExact ()
+  : m_slots (INITIAL_TABLE_SIZE)
+  , m_size (0)
+  , m_maxSize (0)
+{
+}
+
+HashExact::~HashExact ()
+{
+}
+
+void
+HashExact::NotifyNewAggregate ()
+{
+  if (m_fib == 0)
+    {
+      m_fib = GetObject<Fib> ();
+    }
+  if (m_forwardingStrategy == 0)
+    {
+      m_forwardingStrategy = GetObject<ForwardingStrategy> ();
+    }
+
+  Pit::NotifyNewAggregate ();
+}
+
+void
+HashExact::DoDispose ()
+{
+  std::vector<Slot> ().swap (m_slots); // entries have references to PIT
+  m_size = 0;
+  m_lengths.clear ();
+  Simulator::Remove (m_cleanEvent);
+
+  m_forwardingStrategy = 0;
+  m_fib = 0;
+
+  Pit::DoDispose ();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+HashExact::HashEntry::HashEntry (HashExact &pit, Ptr<const Interest> header, Ptr<fib::Entry> fibEntry)
+  : Entry (pit, header, fibEntry)
+{
+  pit.m_timers.Insert (*this);
+  pit.ScheduleCleaning (GetExpireTime ());
+}
+
+HashExact::HashEntry::~HashEntry ()
+{
+  time_hook_.unlink ();
+}
+
+void
+HashExact::HashEntry::UpdateLifetime (const Time &offsetTime)
+{
+  HashExact &pit = static_cast<HashExact&> (m_container);
+
+  pit.m_timers.Erase (*this);
+  Entry::UpdateLifetime (offsetTime);
+  pit.m_timers.Insert (*this);
+
+  pit.ScheduleCleaning (GetExpireTime ());
+}
+
+void
+HashExact::HashEntry::OffsetLifetime (const Time &offsetTime)
+{
+  HashExact &pit = static_cast<HashExact&> (m_container);
+
+  pit.m_timers.Erase (*this);
+  Entry::OffsetLifetime (offsetTime);
+  pit.m_timers.Insert (*this);
+
+  pit.ScheduleCleaning (GetExpireTime ());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template<class NameLike>
+uint32_t
+HashExact::FindSlot (const NameLike &name) const
+{
+  if (m_lengths.size () <= name.size () || m_lengths[name.size ()] == 0)
+    return m_slots.size (); // no entries with names of this length
+
+  std::size_t hash = name.GetPrefixHash (name.size ());
+  uint32_t mask = m_slots.size () - 1;
+  for (uint32_t slot = hash & mask; m_slots[slot].m_entry != 0; slot = (slot + 1) & mask)
+    {
+      if (m_slots[slot].m_hash != hash)
+        continue;
+
+      const Name &prefix = m_slots[slot].m_entry->GetName ();
+      if (prefix.size () != name.size ())
+        continue;
+
+      bool equal = true;
+      for (size_t i = name.size (); i > 0; i--) // last components are more likely to differ
+        {
+          if (prefix.get (i - 1) != name.get (i - 1))
+            {
+              equal = false;
+              break;
+            }
+        }
+      if (equal)
+        return slot;
+    }
+  return m_slots.size ();
+}
+
+uint32_t
+HashExact::FindSlot (const HashEntry &entry) const
+{
+  uint32_t mask = m_slots.size () - 1;
+  const Name &prefix = entry.GetName ();
+  for (uint32_t slot = prefix.GetPrefixHash (prefix.size ()) & mask;
+       m_slots[slot].m_entry != 0;
+       slot = (slot + 1) & mask)
+    {
+      if (PeekPointer (m_slots[slot].m_entry) == &entry)
+        return slot;
+    }
+  return m_slots.size ();
+}
+
+void
+HashExact::Insert (Ptr<HashEntry> entry)
+{
+  const Name &prefix = entry->GetName ();
+  std::size_t hash = prefix.GetPrefixHash (prefix.size ());
+
+  uint32_t mask = m_slots.size () - 1;
+  uint32_t slot = hash & mask;
+  while (m_slots[slot].m_entry != 0)
+    slot = (slot + 1) & mask;
+
+  m_slots[slot].m_hash = hash;
+  m_slots[slot].m_entry = entry;
+}
+
+void
+HashExact::Erase (uint32_t slot)
+{
+  Ptr<HashEntry> entry = m_slots[slot].m_entry;
+  m_timers.Erase (*entry);
+  ReleaseFaceEntry (*entry);
+
+  m_size --;
+  m_lengths[entry->GetName ().size ()] --;
+
+  // backward shift deletion: entries after the hole that can be placed into it, are moved
+  uint32_t mask = m_slots.size () - 1;
+  uint32_t hole = slot;
+  for (uint32_t next = (hole + 1) & mask; m_slots[next].m_entry != 0; next = (next + 1) & mask)
+    {
+      uint32_t home = m_slots[next].m_hash & mask;
+      bool stays = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+      if (stays)
+        continue;
+
+      m_slots[hole] = m_slots[next];
+      hole = next;
+    }
+  m_slots[hole].m_entry = 0;
+}
+
+void
+HashExact::Rehash (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+
+  std::vector<Slot> slots (size);
+  slots.swap (m_slots);
+
+  for (std::vector<Slot>::iterator slot = slots.begin (); slot != slots.end (); slot++)
+    {
+      if (slot->m_entry != 0)
+        Insert (slot->m_entry);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Ptr<Entry>
+HashExact::Lookup (const ContentObject &header)
+{
+  const Name &name = header.GetName ();
+  for (size_t length = name.size () + 1; length > 0; length--) // FindSlot skips lengths without entries
+    {
+      uint32_t slot = FindSlot (PrefixView (name, length - 1));
+      if (slot != m_slots.size () && EntryIsNotEmpty () (m_slots[slot].m_entry))
+        return m_slots[slot].m_entry;
+    }
+  return 0;
+}
+
+std::vector< Ptr<Entry> >
+HashExact::FindAllMatches (const ContentObject &header)
+{
+  std::vector< Ptr<Entry> > entries;
+
+  const Name &name = header.GetName ();
+  for (size_t length = name.size () + 1; length > 0; length--) // FindSlot skips lengths without entries
+    {
+      uint32_t slot = FindSlot (PrefixView (name, length - 1));
+      if (slot != m_slots.size () && EntryIsNotEmpty () (m_slots[slot].m_entry))
+        entries.push_back (m_slots[slot].m_entry);
+    }
+  return entries;
+}
+
+Ptr<Entry>
+HashExact::Lookup (const Interest &header)
+{
+  NS_ASSERT_MSG (m_fib != 0, "FIB should be set");
+  NS_ASSERT_MSG (m_forwardingStrategy != 0, "Forwarding strategy  should be set");
+
+  return Find (header.GetName ());
+}
+
+Ptr<Entry>
+HashExact::Find (const Name &prefix)
+{
+  uint32_t slot = FindSlot (prefix);
+  if (slot == m_slots.size ())
+    return 0;
+  else
+    return m_slots[slot].m_entry;
+}
+
+Ptr<Entry>
+HashExact::Find (const PrefixView &prefix)
+{
+  uint32_t slot = FindSlot (prefix);
+  if (slot == m_slots.size ())
+    return 0;
+  else
+    return m_slots[slot].m_entry;
+}
+
+Ptr<Entry>
+HashExact::Create (Ptr<const Interest> header)
+{
+  NS_LOG_DEBUG (header->GetName ());
+
+  uint32_t slot = FindSlot (header->GetName ());
+  if (slot != m_slots.size ())
+    return m_slots[slot].m_entry;
+
+  if (m_maxSize != 0 && m_size >= m_maxSize)
+    return 0; // PIT is full, new entries are rejected
+
+  Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
+  if (fibEntry == 0)
+    return 0;
+
+  if (2 * (m_size + 1) > m_slots.size ())
+    Rehash (2 * m_slots.size ()); // keep load factor below 1/2, so probe sequences are short
+
+  Ptr<HashEntry> entry = ns3::Create<HashEntry> (boost::ref (*this), header, fibEntry);
+  Insert (entry);
+
+  size_t length = header->GetName ().size ();
+  if (m_lengths.size () <= length)
+    m_lengths.resize (length + 1, 0);
+  m_lengths[length] ++;
+  m_size ++;
+
+  return entry;
+}
+
+void
+HashExact::MarkErased (Ptr<Entry> item)
+{
+  const Name &prefix = StaticCast<HashEntry> (item)->GetName ();
+  AddDeadNonces (prefix.GetPrefixHash (prefix.size ()), *item);
+
+  if (this->m_PitEntryPruningTimout.IsZero ())
+    {
+      uint32_t slot = FindSlot (*StaticCast<HashEntry> (item));
+      if (slot != m_slots.size ())
+        Erase (slot);
+    }
+  else
+    {
+      item->OffsetLifetime (this->m_PitEntryPruningTimout - item->GetExpireTime () + Simulator::Now ());
+    }
+}
+
+void
+HashExact::Print (std::ostream &os) const
+{
+  for (std::vector<Slot>::const_iterator slot = m_slots.begin (); slot != m_slots.end (); slot++)
+    {
+      if (slot->m_entry == 0) continue;
+
+      os << slot->m_entry->GetPrefix () << "\t" << *slot->m_entry << "\n";
+    }
+}
+
+uint32_t
+HashExact::GetSize () const
+{
+  return m_size;
+}
+
+Ptr<Entry>
+HashExact::FindFrom (uint32_t slot) const
+{
+  for (; slot < m_slots.size (); slot++)
+    {
+      if (m_slots[slot].m_entry != 0)
+        return m_slots[slot].m_entry;
+    }
+  return 0;
+}
+
+Ptr<Entry>
+HashExact::Begin ()
+{
+  return FindFrom (0);
+}
+
+Ptr<Entry>
+HashExact::End ()
+{
+  return 0;
+}
+
+Ptr<Entry>
+HashExact::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  uint32_t slot = FindSlot (*StaticCast<HashEntry> (from));
+  NS_ASSERT (slot != m_slots.size ());
+
+  return FindFrom (slot + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Time
+HashExact::GetTimerGranularity () const
+{
+  return m_timers.GetGranularity ();
+}
+
+void
+HashExact::SetTimerGranularity (const Time &granularity)
+{
+  m_timers.SetGranularity (granularity);
+  RescheduleCleaning ();
+}
+
+void
+HashExact::ScheduleCleaning (const Time &expireTime)
+{
+  Time deadline = std::max (m_timers.GetDeadline (expireTime), Simulator::Now ());
+  if (m_cleanEvent.IsRunning () && m_cleanTime <= deadline)
+    return; // entry will be processed by the already scheduled cleaning
+
+  Simulator::Remove (m_cleanEvent);
+  m_cleanTime = deadline;
+  m_cleanEvent = Simulator::Schedule (m_cleanTime - Simulator::Now (),
+                                      &HashExact::CleanExpired, this);
+}
+
+void
+HashExact::RescheduleCleaning ()
+{
+  Simulator::Remove (m_cleanEvent);
+
+  Time deadline;
+  if (!m_timers.GetNextDeadline (deadline))
+    return;
+
+  m_cleanTime = std::max (deadline, Simulator::Now ());
+  NS_LOG_DEBUG ("Schedule next cleaning at " << m_cleanTime.ToDouble (Time::S) << "s abs time");
+
+  m_cleanEvent = Simulator::Schedule (m_cleanTime - Simulator::Now (),
+                                      &HashExact::CleanExpired, this);
+}
+
+void
+HashExact::CleanExpired ()
+{
+  NS_LOG_LOGIC ("Cleaning PIT. Total: " << m_size);
+
+  timer_wheel::item_list expired;
+  m_timers.Advance (Simulator::Now (), expired);
+
+  while (!expired.empty ())
+    {
+      Ptr<HashEntry> entry = &expired.front ();
+      expired.pop_front ();
+
+      m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry);
+
+      uint32_t slot = FindSlot (*entry);
+      if (slot != m_slots.size ())
+        Erase (slot);
+    }
+
+  RescheduleCleaning ();
+}
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,234 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_HASH_EXACT_H_
+#define	_NDN_PIT_HASH_EXACT_H_
+
+#include "ndn-pit.h"
+#include "ndn-pit-timer-wheel.h"
+
+#include "ns3/ndn-name.h"
+
+#include "../../utils/trie/trie-allocator.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class Fib;
+class ForwardingStrategy;
+
+namespace pit {
+
+/**
+ * \ingroup ndn
+ * \brief PIT implementation, in which entries are kept in a single open-addressing hash table,
+ *        keyed by hash of the full name of the entry
+ *
+ * Interest lookup, creation and removal of PIT entries take a single probe sequence (linear probing
+ * over the cached hashes of Name).  PIT entries that can be satisfied by Data are found by probing
+ * the table with hashes of all prefixes of the Data name, skipping lengths for which there are no
+ * PIT entries.  Unlike trie-based PITs, no per-component nodes are allocated, which is beneficial
+ * for PITs with a high churn of entries (e.g., on consumer-facing nodes).
+ *
+ * Similar to Persistent PIT, new entries are rejected when the number of entries reaches MaxSize.
+ *
+ * To use this implementation instead of the default PIT:
+ *
+ *     ndnHelper.SetPit ("ns3::ndn::pit::HashExact");
+ */
+class HashExact : public Pit
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief PIT constructor
+   */
+  HashExact ();
+
+  /**
+   * \brief Destructor
+   */
+  virtual ~HashExact ();
+
+  // inherited from Pit
+  virtual Ptr<Entry>
+  Lookup (const ContentObject &header);
+
+  virtual std::vector< Ptr<Entry> >
+  FindAllMatches (const ContentObject &header);
+
+  virtual Ptr<Entry>
+  Lookup (const Interest &header);
+
+  virtual Ptr<Entry>
+  Find (const Name &prefix);
+
+  virtual Ptr<Entry>
+  Find (const PrefixView &prefix);
+
+  virtual Ptr<Entry>
+  Create (Ptr<const Interest> header);
+
+  virtual void
+  MarkErased (Ptr<Entry> entry);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<Entry>
+  Begin ();
+
+  virtual Ptr<Entry>
+  End ();
+
+  /**
+   * @brief Advance the iterator
+   *
+   * Entries are visited in the order of table slots.  Note that this iteration is not erase-safe: removal
+   * of an entry (e.g., MarkErased) moves the following entries of its probe sequence backward, so they
+   * can be skipped or visited twice.  Collect entries first and erase them after the iteration
+   */
+  virtual Ptr<Entry>
+  Next (Ptr<Entry>);
+
+protected:
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  /**
+   * @brief PIT entry, which keeps itself in the timer wheel of the PIT
+   */
+  class HashEntry : public Entry,
+                    public ndnSIM::pool_allocated<HashEntry>
+  {
+  public:
+    HashEntry (HashExact &pit, Ptr<const Interest> header, Ptr<fib::Entry> fibEntry);
+
+    virtual ~HashEntry ();
+
+    virtual void
+    UpdateLifetime (const Time &offsetTime);
+
+    virtual void
+    OffsetLifetime (const Time &offsetTime);
+
+    /**
+     * @brief Get prefix of the entry without making a copy (entries of hash PIT always keep the prefix)
+     */
+    inline const Name &
+    GetName () const
+    {
+      return m_prefix;
+    }
+
+  public:
+    TimerWheelHook time_hook_;
+  };
+
+  /**
+   * @brief Cell of the hash table
+   */
+  struct Slot
+  {
+    std::size_t m_hash;      ///< @brief Hash of the entry name (cached to avoid name comparisons)
+    Ptr<HashEntry> m_entry;  ///< @brief PIT entry (0 if the slot is empty)
+  };
+
+  /**
+   * @brief Find slot of the entry with the name
+   * @returns index of the slot or m_slots.size () if there is no such entry
+   */
+  template<class NameLike>
+  uint32_t
+  FindSlot (const NameLike &name) const;
+
+  /**
+   * @brief Find slot, in which the entry is placed
+   */
+  uint32_t
+  FindSlot (const HashEntry &entry) const;
+
+  /**
+   * @brief Place entry into the first empty slot of its probe sequence
+   */
+  void
+  Insert (Ptr<HashEntry> entry);
+
+  /**
+   * @brief Remove entry from the slot, moving back entries of the same probe sequence (no tombstones)
+   */
+  void
+  Erase (uint32_t slot);
+
+  /**
+   * @brief Place all entries into the new table of the specified size (power of 2)
+   */
+  void
+  Rehash (uint32_t size);
+
+  /**
+   * @brief Get first non-empty slot, starting from the specified one
+   */
+  Ptr<Entry>
+  FindFrom (uint32_t slot) const;
+
+  void ScheduleCleaning (const Time &expireTime); ///< @brief Make sure cleaning is scheduled not later than entry expires
+  void RescheduleCleaning (); ///< @brief Schedule cleaning for the nearest non-empty tick of the timer wheel
+  void CleanExpired ();
+
+  Time
+  GetTimerGranularity () const;
+
+  void
+  SetTimerGranularity (const Time &granularity);
+
+private:
+  std::vector<Slot> m_slots;       ///< @brief Hash table (size is always power of 2)
+  uint32_t m_size;                 ///< @brief Number of PIT entries
+  uint32_t m_maxSize;              ///< @brief Maximum number of PIT entries (0 if not limited)
+  std::vector<uint32_t> m_lengths; ///< @brief Number of PIT entries for each name length
+
+  EventId m_cleanEvent;
+  Time m_cleanTime; ///< @brief Time, for which m_cleanEvent is scheduled
+  Ptr<Fib> m_fib; ///< \brief Link to FIB table
+  Ptr<ForwardingStrategy> m_forwardingStrategy;
+
+  typedef TimerWheel<HashEntry, &HashEntry::time_hook_> timer_wheel;
+  timer_wheel m_timers;
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_PIT_HASH_EXACT_H_ */
@@ -54,6 +54,15 @@ namespace ll = boost::lambda;
     }                                                   \
   } x_ ## type ## templ ## RegistrationVariable
 
+#define NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(type, templ, engine)  \
+  static struct X ## type ## templ ## engine ## RegistrationClass     \
+  {                                                                   \
+    X ## type ## templ ## engine ## RegistrationClass () {            \
+      ns3::TypeId tid = type<templ, engine>::GetTypeId ();            \
+      tid.GetParent ();                                               \
+    }                                                                 \
+  } x_ ## type ## templ ## engine ## RegistrationVariable
+
 namespace ns3 {
 namespace ndn {
 namespace pit {
@@ -82,6 +91,15 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, random_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, lru_policy_traits);
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(PitImpl, serialized_size_policy_traits);
 
+// path-compressed (radix) trie variants, better suited for long names
+template class PitImpl<persistent_policy_traits, radix_trie>;
+template class PitImpl<random_policy_traits, radix_trie>;
+template class PitImpl<lru_policy_traits, radix_trie>;
+
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(PitImpl, persistent_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(PitImpl, random_policy_traits, radix_trie);
+NS_OBJECT_ENSURE_REGISTERED_TEMPL_ENGINE(PitImpl, lru_policy_traits, radix_trie);
+
 
 typedef multi_policy_traits< boost::mpl::vector2< persistent_policy_traits,
                                                   aggregate_stats_policy_traits > > PersistentWithCountsTraits;
@@ -126,6 +144,21 @@ class Lru : public PitImpl<lru_policy_traits> { };
  */
 class SerializedSize : public PitImpl<serialized_size_policy_traits> { };
 
+/**
+ * @brief Variant of Persistent PIT that uses path-compressed trie (radix_trie)
+ */
+class PersistentRadix : public PitImpl<persistent_policy_traits, radix_trie> { };
+
+/**
+ * @brief Variant of Random PIT that uses path-compressed trie (radix_trie)
+ */
+class RandomRadix : public PitImpl<random_policy_traits, radix_trie> { };
+
+/**
+ * @brief Variant of Lru PIT that uses path-compressed trie (radix_trie)
+ */
+class LruRadix : public PitImpl<lru_policy_traits, radix_trie> { };
+
 #endif
 
 } // namespace pit
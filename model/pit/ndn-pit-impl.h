@@ -25,8 +25,11 @@
 
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/boolean.h"
 
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/trie/radix-trie.h"
+#include "ndn-pit-timer-wheel.h"
 #include "ndn-pit-entry-impl.h"
 
 #include "ns3/ndn-interest.h"
@@ -46,21 +49,28 @@ namespace pit {
  * \ingroup ndn
  * \brief Class implementing Pending Interests Table
  */
-template<class Policy>
+template<class Policy,
+         template<typename, typename, typename, typename, typename> class Engine = ndnSIM::trie>
 class PitImpl : public Pit
               , protected ndnSIM::trie_with_policy<Name,
-                                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy > > >,
+                                                   EntryPayloadTraits< EntryImpl< PitImpl< Policy, Engine > > >,
                                                    // ndnSIM::persistent_policy_traits
-                                                   Policy
+                                                   Policy,
+                                                   ndnSIM::component_key_traits<Name>,
+                                                   ndnSIM::slab_allocator,
+                                                   Engine
                                                    >
 {
 public:
   typedef ndnSIM::trie_with_policy<Name,
-                                   ndnSIM::smart_pointer_payload_traits< EntryImpl< PitImpl< Policy > > >,
+                                   EntryPayloadTraits< EntryImpl< PitImpl< Policy, Engine > > >,
                                    // ndnSIM::persistent_policy_traits
-                                   Policy
+                                   Policy,
+                                   ndnSIM::component_key_traits<Name>,
+                                   ndnSIM::slab_allocator,
+                                   Engine
                                    > super;
-  typedef EntryImpl< PitImpl< Policy > > entry;
+  typedef EntryImpl< PitImpl< Policy, Engine > > entry;
 
   /**
    * \brief Interface ID
@@ -83,12 +93,18 @@ public:
   virtual Ptr<Entry>
   Lookup (const ContentObject &header);
 
+  virtual std::vector< Ptr<Entry> >
+  FindAllMatches (const ContentObject &header);
+
   virtual Ptr<Entry>
   Lookup (const Interest &header);
 
   virtual Ptr<Entry>
   Find (const Name &prefix);
 
+  virtual Ptr<Entry>
+  Find (const PrefixView &prefix);
+
   virtual Ptr<Entry>
   Create (Ptr<const Interest> header);
 
@@ -117,7 +133,8 @@ public:
   GetPolicy () { return super::getPolicy (); }
 
 protected:
-  void RescheduleCleaning ();
+  void ScheduleCleaning (const Time &expireTime); ///< @brief Make sure cleaning is scheduled not later than entry expires
+  void RescheduleCleaning (); ///< @brief Schedule cleaning for the nearest non-empty tick of the timer wheel
   void CleanExpired ();
 
   // inherited from Object class
@@ -134,22 +151,24 @@ private:
   uint32_t
   GetCurrentSize () const;
 
+  Time
+  GetTimerGranularity () const;
+
+  void
+  SetTimerGranularity (const Time &granularity);
+
 private:
+  bool m_leanEntries; ///< @brief Entries release the Interest and the prefix, once they are placed in the trie
   EventId m_cleanEvent;
+  Time m_cleanTime; ///< @brief Time, for which m_cleanEvent is scheduled
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
   Ptr<ForwardingStrategy> m_forwardingStrategy;
 
   static LogComponent g_log; ///< @brief Logging variable
 
-  // indexes
-  typedef
-  boost::intrusive::multiset<entry,
-                        boost::intrusive::compare < TimestampIndex< entry > >,
-                        boost::intrusive::member_hook< entry,
-                                                       boost::intrusive::set_member_hook<>,
-                                                       &entry::time_hook_>
-                        > time_index;
-  time_index i_time;
+  // expiration of entries
+  typedef TimerWheel<entry, &entry::time_hook_> timer_wheel;
+  timer_wheel m_timers;
 
   friend class EntryImpl< PitImpl >;
 };
@@ -158,69 +177,99 @@ private:
 ////////// Implementation ////////////////
 //////////////////////////////////////////
 
-template<class Policy>
-LogComponent PitImpl< Policy >::g_log = LogComponent (("ndn.pit." + Policy::GetName ()).c_str ());
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+LogComponent PitImpl<Policy, Engine>::g_log = LogComponent (("ndn.pit." + Policy::GetName () + super::parent_trie::GetName ()).c_str ());
 
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 TypeId
-PitImpl< Policy >::GetTypeId ()
+PitImpl<Policy, Engine>::GetTypeId ()
 {
-  static TypeId tid = TypeId (("ns3::ndn::pit::"+Policy::GetName ()).c_str ())
+  static TypeId tid = TypeId (("ns3::ndn::pit::"+Policy::GetName ()+super::parent_trie::GetName ()).c_str ())
     .SetGroupName ("Ndn")
     .SetParent<Pit> ()
-    .AddConstructor< PitImpl< Policy > > ()
+    .AddConstructor< PitImpl<Policy, Engine> > ()
     .AddAttribute ("MaxSize",
                    "Set maximum size of PIT in bytes. If 0, limit is not enforced",
                    UintegerValue (0),
-                   MakeUintegerAccessor (&PitImpl< Policy >::GetMaxSize,
-                                         &PitImpl< Policy >::SetMaxSize),
+                   MakeUintegerAccessor (&PitImpl<Policy, Engine>::GetMaxSize,
+                                         &PitImpl<Policy, Engine>::SetMaxSize),
                    MakeUintegerChecker<uint32_t> ())
 
     .AddAttribute ("CurrentSize", "Get current size of PIT in bytes",
                    TypeId::ATTR_GET,
                    UintegerValue (0),
-                   MakeUintegerAccessor (&PitImpl< Policy >::GetCurrentSize),
+                   MakeUintegerAccessor (&PitImpl<Policy, Engine>::GetCurrentSize),
                    MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("TimerGranularity",
+                   "Granularity of PIT entry expiration. Expired entries are removed in batches, at most this time late",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&PitImpl<Policy, Engine>::GetTimerGranularity,
+                                     &PitImpl<Policy, Engine>::SetTimerGranularity),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("LeanEntries",
+                   "If true, PIT entries do not keep the Interest and the prefix (prefix is restored from the trie on demand). "
+                   "Saves memory for large PITs, but GetInterest and the first GetPrefix call on an entry become more expensive",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PitImpl<Policy, Engine>::m_leanEntries),
+                   MakeBooleanChecker ())
     ;
 
   return tid;
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 uint32_t
-PitImpl<Policy>::GetCurrentSize () const
+PitImpl<Policy, Engine>::GetCurrentSize () const
 {
   return super::getPolicy ().size ();
 }
 
-template<class Policy>
-PitImpl<Policy>::PitImpl ()
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+PitImpl<Policy, Engine>::PitImpl ()
+  : m_leanEntries (false)
 {
 }
 
-template<class Policy>
-PitImpl<Policy>::~PitImpl ()
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+PitImpl<Policy, Engine>::~PitImpl ()
 {
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 uint32_t
-PitImpl<Policy>::GetMaxSize () const
+PitImpl<Policy, Engine>::GetMaxSize () const
 {
   return super::getPolicy ().get_max_size ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::SetMaxSize (uint32_t maxSize)
+PitImpl<Policy, Engine>::SetMaxSize (uint32_t maxSize)
 {
   super::getPolicy ().set_max_size (maxSize);
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+Time
+PitImpl<Policy, Engine>::GetTimerGranularity () const
+{
+  return m_timers.GetGranularity ();
+}
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+void
+PitImpl<Policy, Engine>::SetTimerGranularity (const Time &granularity)
+{
+  m_timers.SetGranularity (granularity);
+  RescheduleCleaning ();
+}
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::NotifyNewAggregate ()
+PitImpl<Policy, Engine>::NotifyNewAggregate ()
 {
   if (m_fib == 0)
     {
@@ -234,11 +283,12 @@ PitImpl<Policy>::NotifyNewAggregate ()
   Pit::NotifyNewAggregate ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::DoDispose ()
+PitImpl<Policy, Engine>::DoDispose ()
 {
   super::clear ();
+  Simulator::Remove (m_cleanEvent);
 
   m_forwardingStrategy = 0;
   m_fib = 0;
@@ -246,61 +296,69 @@ PitImpl<Policy>::DoDispose ()
   Pit::DoDispose ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::RescheduleCleaning ()
+PitImpl<Policy, Engine>::ScheduleCleaning (const Time &expireTime)
+{
+  Time deadline = std::max (m_timers.GetDeadline (expireTime), Simulator::Now ());
+  if (m_cleanEvent.IsRunning () && m_cleanTime <= deadline)
+    return; // entry will be processed by the already scheduled cleaning
+
+  Simulator::Remove (m_cleanEvent);
+  m_cleanTime = deadline;
+  m_cleanEvent = Simulator::Schedule (m_cleanTime - Simulator::Now (),
+                                      &PitImpl<Policy, Engine>::CleanExpired, this);
+}
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+void
+PitImpl<Policy, Engine>::RescheduleCleaning ()
 {
   // m_cleanEvent.Cancel ();
   Simulator::Remove (m_cleanEvent); // slower, but better for memory
-  if (i_time.empty ())
+
+  Time deadline;
+  if (!m_timers.GetNextDeadline (deadline))
     {
       // NS_LOG_DEBUG ("No items in PIT");
       return;
     }
 
-  Time nextEvent = i_time.begin ()->GetExpireTime () - Simulator::Now ();
-  if (nextEvent <= 0) nextEvent = Seconds (0);
+  m_cleanTime = std::max (deadline, Simulator::Now ());
+  NS_LOG_DEBUG ("Schedule next cleaning at " << m_cleanTime.ToDouble (Time::S) << "s abs time");
 
-  NS_LOG_DEBUG ("Schedule next cleaning in " <<
-                nextEvent.ToDouble (Time::S) << "s (at " <<
-                i_time.begin ()->GetExpireTime () << "s abs time");
-
-  m_cleanEvent = Simulator::Schedule (nextEvent,
-                                      &PitImpl<Policy>::CleanExpired, this);
+  m_cleanEvent = Simulator::Schedule (m_cleanTime - Simulator::Now (),
+                                      &PitImpl<Policy, Engine>::CleanExpired, this);
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::CleanExpired ()
+PitImpl<Policy, Engine>::CleanExpired ()
 {
-  NS_LOG_LOGIC ("Cleaning PIT. Total: " << i_time.size ());
-  Time now = Simulator::Now ();
+  NS_LOG_LOGIC ("Cleaning PIT. Total: " << super::getPolicy ().size ());
+
+  typename timer_wheel::item_list expired;
+  m_timers.Advance (Simulator::Now (), expired);
 
-  // uint32_t count = 0;
-  while (!i_time.empty ())
+  while (!expired.empty ())
     {
-      typename time_index::iterator entry = i_time.begin ();
-      if (entry->GetExpireTime () <= now) // is the record stale?
-        {
-          m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry->to_iterator ()->payload ());
-          super::erase (entry->to_iterator ());
-          // count ++;
-        }
-      else
-        break; // nothing else to do. All later records will not be stale
+      entry &item = expired.front ();
+      expired.pop_front ();
+
+      m_forwardingStrategy->WillEraseTimedOutPendingInterest (item.to_iterator ()->payload ());
+      super::erase (item.to_iterator ());
     }
 
   if (super::getPolicy ().size ())
     {
       NS_LOG_DEBUG ("Size: " << super::getPolicy ().size ());
-      NS_LOG_DEBUG ("i_time size: " << i_time.size ());
     }
   RescheduleCleaning ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::Lookup (const ContentObject &header)
+PitImpl<Policy, Engine>::Lookup (const ContentObject &header)
 {
   /// @todo use predicate to search with exclude filters
   typename super::iterator item = super::longest_prefix_match_if (header.GetName (), EntryIsNotEmpty ());
@@ -311,9 +369,25 @@ PitImpl<Policy>::Lookup (const ContentObject &header)
     return item->payload (); // which could also be 0
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+std::vector< Ptr<Entry> >
+PitImpl<Policy, Engine>::FindAllMatches (const ContentObject &header)
+{
+  std::vector<typename super::iterator> items;
+  super::all_prefix_matches_if (header.GetName (), EntryIsNotEmpty (), items);
+
+  std::vector< Ptr<Entry> > entries;
+  entries.reserve (items.size ());
+  for (typename std::vector<typename super::iterator>::iterator item = items.begin (); item != items.end (); item++)
+    {
+      entries.push_back ((*item)->payload ());
+    }
+  return entries;
+}
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::Lookup (const Interest &header)
+PitImpl<Policy, Engine>::Lookup (const Interest &header)
 {
   // NS_LOG_FUNCTION (header.GetName ());
   NS_ASSERT_MSG (m_fib != 0, "FIB should be set");
@@ -329,9 +403,9 @@ PitImpl<Policy>::Lookup (const Interest &header)
     return lastItem->payload (); // which could also be 0
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::Find (const Name &prefix)
+PitImpl<Policy, Engine>::Find (const Name &prefix)
 {
   typename super::iterator item = super::find_exact (prefix);
 
@@ -341,10 +415,22 @@ PitImpl<Policy>::Find (const Name &prefix)
     return item->payload ();
 }
 
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
+Ptr<Entry>
+PitImpl<Policy, Engine>::Find (const PrefixView &prefix)
+{
+  typename super::iterator item = super::find_exact (prefix);
+
+  if (item == super::end ())
+    return 0;
+  else
+    return item->payload ();
+}
 
-template<class Policy>
+
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::Create (Ptr<const Interest> header)
+PitImpl<Policy, Engine>::Create (Ptr<const Interest> header)
 {
   NS_LOG_DEBUG (header->GetName ());
   Ptr<fib::Entry> fibEntry = m_fib->LongestPrefixMatch (*header);
@@ -362,6 +448,8 @@ PitImpl<Policy>::Create (Ptr<const Interest> header)
       if (result.second)
         {
           newEntry->SetTrie (result.first);
+          if (m_leanEntries)
+            newEntry->MakeLean ();
           return newEntry;
         }
       else
@@ -376,13 +464,16 @@ PitImpl<Policy>::Create (Ptr<const Interest> header)
 }
 
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::MarkErased (Ptr<Entry> item)
+PitImpl<Policy, Engine>::MarkErased (Ptr<Entry> item)
 {
+  typename super::iterator node = StaticCast< entry > (item)->to_iterator ();
+  this->AddDeadNonces (node->full_key_hash (), *item);
+
   if (this->m_PitEntryPruningTimout.IsZero ())
     {
-      super::erase (StaticCast< entry > (item)->to_iterator ());
+      super::erase (node);
     }
   else
     {
@@ -391,9 +482,9 @@ PitImpl<Policy>::MarkErased (Ptr<Entry> item)
 }
 
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 void
-PitImpl<Policy>::Print (std::ostream& os) const
+PitImpl<Policy, Engine>::Print (std::ostream& os) const
 {
   // !!! unordered_set imposes "random" order of item in the same level !!!
   typename super::parent_trie::const_recursive_iterator item (super::getTrie ()), end (0);
@@ -405,16 +496,16 @@ PitImpl<Policy>::Print (std::ostream& os) const
     }
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 uint32_t
-PitImpl<Policy>::GetSize () const
+PitImpl<Policy, Engine>::GetSize () const
 {
   return super::getPolicy ().size ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::Begin ()
+PitImpl<Policy, Engine>::Begin ()
 {
   typename super::parent_trie::recursive_iterator item (super::getTrie ()), end (0);
   for (; item != end; item++)
@@ -429,16 +520,16 @@ PitImpl<Policy>::Begin ()
     return item->payload ();
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::End ()
+PitImpl<Policy, Engine>::End ()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, template<typename, typename, typename, typename, typename> class Engine>
 Ptr<Entry>
-PitImpl<Policy>::Next (Ptr<Entry> from)
+PitImpl<Policy, Engine>::Next (Ptr<Entry> from)
 {
   if (from == 0) return 0;
 
@@ -0,0 +1,364 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef _NDN_PIT_TIMER_WHEEL_H_
+#define	_NDN_PIT_TIMER_WHEEL_H_
+
+#include "ns3/nstime.h"
+#include "ns3/assert.h"
+
+#include <boost/intrusive/list.hpp>
+
+#include <algorithm>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace pit {
+
+/**
+ * @brief Hook that items should have to be placed into TimerWheel (item is removed from the wheel when hook is destroyed)
+ */
+typedef boost::intrusive::list_member_hook< boost::intrusive::link_mode<boost::intrusive::auto_unlink> > TimerWheelHook;
+
+/**
+ * @ingroup ndn
+ * @brief Hierarchical timer wheel, used to expire PIT entries in batches without a simulator event per entry
+ *
+ * Time is divided into ticks of the configured granularity, and ticks are grouped into blocks of SLOTS ticks.
+ * Item that expires at time T belongs to the first tick at or after T.  Items of the current block are kept in
+ * per-tick slots, items of the next SLOTS-1 blocks in per-block slots (moved to per-tick slots when their block
+ * starts), and more distant items in an overflow list (revisited once every SLOTS blocks).  As a result, every
+ * per-tick slot contains only items that are due at this tick, and Advance never touches items that have not expired.
+ *
+ * Insert and erase are O(1).  Items are never reported expired before their expiration time and at most
+ * one tick after it.
+ *
+ * Item should provide GetExpireTime () method.
+ */
+template<class Item, TimerWheelHook Item::*Hook>
+class TimerWheel
+{
+public:
+  typedef boost::intrusive::list< Item,
+                                  boost::intrusive::member_hook< Item, TimerWheelHook, Hook >,
+                                  boost::intrusive::constant_time_size<false> > item_list;
+
+  static const uint32_t SLOTS = 1024; ///< @brief number of slots in each level, should be power of 2 (at least 64)
+
+  TimerWheel ()
+    : m_granularity (MilliSeconds (1))
+    , m_cursor (0)
+    , m_overflowFirst (0)
+  {
+    std::fill (m_blocksFirst, m_blocksFirst + SLOTS, 0);
+    std::fill (m_ticksUsed, m_ticksUsed + WORDS, 0);
+    std::fill (m_blocksUsed, m_blocksUsed + WORDS, 0);
+  }
+
+  /**
+   * @brief Place item into the wheel, according to its expiration time
+   */
+  inline void
+  Insert (Item &item)
+  {
+    Place (item, std::max (GetTick (item.GetExpireTime ()), m_cursor)); // already expired items go into the next processed slot
+  }
+
+  /**
+   * @brief Remove item from the wheel (no-op if it is not there)
+   */
+  inline void
+  Erase (Item &item)
+  {
+    (item.*Hook).unlink ();
+  }
+
+  /**
+   * @brief Move all items that expired before or at the specified time to the list (in no particular order)
+   */
+  void
+  Advance (const Time &now, item_list &expired)
+  {
+    int64_t nowTick = now.GetTimeStep () / m_granularity.GetTimeStep ();
+
+    while (m_cursor <= nowTick)
+      {
+        if (IsEmpty ())
+          {
+            m_cursor = nowTick + 1;
+            break;
+          }
+
+        int64_t blockStart = m_cursor & ~static_cast<int64_t> (SLOTS - 1);
+        int64_t last = std::min (nowTick + 1, blockStart + SLOTS);
+        for (uint32_t slot = FindUsed (m_ticksUsed, m_cursor - blockStart);
+             slot < last - blockStart;
+             slot = FindUsed (m_ticksUsed, slot + 1))
+          {
+            expired.splice (expired.end (), m_ticks[slot]);
+            Unmark (m_ticksUsed, slot);
+          }
+
+        m_cursor = last;
+        if (m_cursor == blockStart + SLOTS)
+          Cascade ();
+      }
+  }
+
+  /**
+   * @brief Get time, when Advance should be called next time
+   *
+   * Deadline is the beginning of the tick, in which the nearest item expires.  If the nearest item has been
+   * erased, deadline can be earlier than necessary (Advance at this time just does not find anything expired)
+   *
+   * @returns false if the wheel is empty
+   */
+  bool
+  GetNextDeadline (Time &deadline)
+  {
+    int64_t blockStart = m_cursor & ~static_cast<int64_t> (SLOTS - 1);
+    for (uint32_t slot = FindUsed (m_ticksUsed, m_cursor - blockStart); slot < SLOTS; slot = FindUsed (m_ticksUsed, slot + 1))
+      {
+        if (!m_ticks[slot].empty ())
+          {
+            deadline = GetTickTime (blockStart + slot);
+            return true;
+          }
+        Unmark (m_ticksUsed, slot); // all items of the slot have been erased
+      }
+
+    // the nearest non-empty block (in cyclic order after the current one)
+    int64_t block = m_cursor / SLOTS;
+    for (uint32_t offset = 1; offset < SLOTS; )
+      {
+        uint32_t slot = (block + offset) & (SLOTS - 1);
+        uint32_t used = FindUsed (m_blocksUsed, slot);
+        if (used == SLOTS)
+          {
+            offset += SLOTS - slot; // continue from the first slot
+            continue;
+          }
+
+        offset += used - slot;
+        if (offset >= SLOTS)
+          break;
+
+        if (!m_blocks[used].empty ())
+          {
+            deadline = GetTickTime (std::max (m_blocksFirst[used], m_cursor));
+            return true;
+          }
+        Unmark (m_blocksUsed, used);
+        offset ++;
+      }
+
+    if (!m_overflow.empty ())
+      {
+        deadline = GetTickTime (std::max (m_overflowFirst, m_cursor));
+        return true;
+      }
+    return false;
+  }
+
+  /**
+   * @brief Get time of the tick, in which item with the specified expiration time will be processed
+   */
+  inline Time
+  GetDeadline (const Time &expireTime) const
+  {
+    return GetTickTime (std::max (GetTick (expireTime), m_cursor));
+  }
+
+  /**
+   * @brief Set duration of one tick (all items are placed into the wheel again)
+   */
+  void
+  SetGranularity (const Time &granularity)
+  {
+    NS_ASSERT (granularity.IsStrictlyPositive ());
+
+    item_list items;
+    for (uint32_t slot = 0; slot < SLOTS; slot++)
+      {
+        items.splice (items.end (), m_ticks[slot]);
+        items.splice (items.end (), m_blocks[slot]);
+      }
+    items.splice (items.end (), m_overflow);
+    std::fill (m_ticksUsed, m_ticksUsed + WORDS, 0);
+    std::fill (m_blocksUsed, m_blocksUsed + WORDS, 0);
+
+    Time processed = GetTickTime (m_cursor);
+    m_granularity = granularity;
+    m_cursor = GetTick (processed);
+
+    Reinsert (items);
+  }
+
+  inline Time
+  GetGranularity () const
+  {
+    return m_granularity;
+  }
+
+private:
+  static const uint32_t WORDS = SLOTS / 64;
+
+  inline int64_t
+  GetTick (const Time &time) const
+  {
+    int64_t step = m_granularity.GetTimeStep ();
+    return (time.GetTimeStep () + step - 1) / step;
+  }
+
+  inline Time
+  GetTickTime (int64_t tick) const
+  {
+    return TimeStep (tick * m_granularity.GetTimeStep ());
+  }
+
+  inline void
+  Place (Item &item, int64_t tick)
+  {
+    int64_t block = tick / SLOTS;
+    int64_t current = m_cursor / SLOTS;
+    if (block == current)
+      {
+        uint32_t slot = tick & (SLOTS - 1);
+        m_ticks[slot].push_back (item);
+        Mark (m_ticksUsed, slot);
+      }
+    else if (block < current + SLOTS)
+      {
+        uint32_t slot = block & (SLOTS - 1);
+        if (m_blocks[slot].empty ())
+          m_blocksFirst[slot] = tick;
+        else
+          m_blocksFirst[slot] = std::min (m_blocksFirst[slot], tick);
+
+        m_blocks[slot].push_back (item);
+        Mark (m_blocksUsed, slot);
+      }
+    else
+      {
+        if (m_overflow.empty ())
+          m_overflowFirst = tick;
+        else
+          m_overflowFirst = std::min (m_overflowFirst, tick);
+
+        m_overflow.push_back (item);
+      }
+  }
+
+  inline void
+  Reinsert (item_list &items)
+  {
+    while (!items.empty ())
+      {
+        Item &item = items.front ();
+        items.pop_front ();
+        Insert (item);
+      }
+  }
+
+  /**
+   * @brief Move items of the block, which has just started, to the per-tick slots
+   */
+  void
+  Cascade ()
+  {
+    int64_t block = m_cursor / SLOTS;
+    uint32_t slot = block & (SLOTS - 1);
+
+    item_list items;
+    if (slot == 0)
+      items.splice (items.end (), m_overflow); // range of per-block slots has moved by SLOTS blocks
+    items.splice (items.end (), m_blocks[slot]);
+    Unmark (m_blocksUsed, slot);
+
+    Reinsert (items);
+  }
+
+  inline bool
+  IsEmpty () const
+  {
+    for (uint32_t word = 0; word < WORDS; word++)
+      {
+        if (m_ticksUsed[word] != 0 || m_blocksUsed[word] != 0)
+          return false;
+      }
+    return m_overflow.empty ();
+  }
+
+  static inline void
+  Mark (uint64_t *used, uint32_t slot)
+  {
+    used[slot / 64] |= static_cast<uint64_t> (1) << (slot % 64);
+  }
+
+  static inline void
+  Unmark (uint64_t *used, uint32_t slot)
+  {
+    used[slot / 64] &= ~(static_cast<uint64_t> (1) << (slot % 64));
+  }
+
+  /**
+   * @brief Find the first slot at or after the specified one, which may be non-empty (SLOTS if there is none)
+   */
+  static inline uint32_t
+  FindUsed (const uint64_t *used, uint32_t slot)
+  {
+    for (uint32_t word = slot / 64; word < WORDS; word++)
+      {
+        uint64_t bits = used[word];
+        if (word == slot / 64)
+          bits &= ~static_cast<uint64_t> (0) << (slot % 64);
+
+        if (bits != 0)
+          {
+            uint32_t bit = 0;
+            while ((bits & 1) == 0)
+              {
+                bits >>= 1;
+                bit ++;
+              }
+            return word * 64 + bit;
+          }
+      }
+    return SLOTS;
+  }
+
+private:
+  Time m_granularity;
+  int64_t m_cursor; ///< @brief the first tick that has not been processed yet
+  item_list m_ticks [SLOTS]; ///< @brief items of the current block, by tick
+  item_list m_blocks [SLOTS]; ///< @brief items of the following blocks, by block
+  item_list m_overflow; ///< @brief items too far in the future for m_blocks
+  uint64_t m_ticksUsed [WORDS]; ///< @brief bitmap of m_ticks slots that may be non-empty
+  uint64_t m_blocksUsed [WORDS]; ///< @brief bitmap of m_blocks slots that may be non-empty
+  int64_t m_blocksFirst [SLOTS]; ///< @brief the earliest tick of items placed into m_blocks slots (not updated on erase)
+  int64_t m_overflowFirst; ///< @brief the earliest tick of items placed into m_overflow (not updated on erase)
+};
+
+} // namespace pit
+} // namespace ndn
+} // namespace ns3
+
+#endif // _NDN_PIT_TIMER_WHEEL_H_
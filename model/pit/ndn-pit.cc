@@ -22,6 +22,7 @@
 
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-content-object.h"
+#include "ns3/ndn-face.h"
 
 #include "ns3/log.h"
 #include "ns3/nstime.h"
@@ -30,6 +31,7 @@
 
 #include <boost/lambda/bind.hpp>
 #include <boost/lambda/lambda.hpp>
+#include <boost/foreach.hpp>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.Pit");
 
@@ -46,7 +48,8 @@ Pit::GetTypeId ()
     .SetParent<Object> ()
 
     .AddAttribute ("PitEntryPruningTimout",
-                   "Timeout for PIT entry to live after being satisfied. To make sure recently satisfied interest will not be satisfied again",
+                   "Timeout for PIT entry to live after being satisfied. To make sure recently satisfied interest will not be satisfied again. "
+                   "Alternatively, looping interests can be detected using dead nonce list, even if entry is removed instantly (see DeadNonceLifetime)",
                    TimeValue (), // by default, PIT entries are removed instantly
                    MakeTimeAccessor (&Pit::m_PitEntryPruningTimout),
                    MakeTimeChecker ())
@@ -57,12 +60,27 @@ Pit::GetTypeId ()
                    TimeValue (), // by default, PIT entries are kept for the time, specified by the InterestLifetime
                    MakeTimeAccessor (&Pit::GetMaxPitEntryLifetime, &Pit::SetMaxPitEntryLifetime),
                    MakeTimeChecker ())
+
+    .AddAttribute ("DeadNonceLifetime",
+                   "Time for which nonces of satisfied (or otherwise erased) PIT entries are remembered to detect looping interests. "
+                   "Zero (default) disables the dead nonce list",
+                   TimeValue (),
+                   MakeTimeAccessor (&Pit::GetDeadNonceLifetime, &Pit::SetDeadNonceLifetime),
+                   MakeTimeChecker ())
+
+    .AddAttribute ("MaxEntriesPerFace",
+                   "Maximum number of PIT entries that can be created by interests from one face. "
+                   "Interests from the face are refused when the limit is reached (0 means no limit)",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&Pit::m_maxEntriesPerFace),
+                   MakeUintegerChecker<uint32_t> ())
     ;
 
   return tid;
 }
 
 Pit::Pit ()
+  : m_maxEntriesPerFace (0)
 {
 }
 
@@ -70,5 +88,84 @@ Pit::~Pit ()
 {
 }
 
+Ptr<pit::Entry>
+Pit::Create (Ptr<const Interest> header, Ptr<Face> inFace)
+{
+  if (inFace == 0)
+    return Create (header);
+
+  uint32_t faceId = inFace->GetId ();
+  if (m_faceEntries.size () <= faceId)
+    m_faceEntries.resize (faceId + 1, 0);
+
+  if (m_maxEntriesPerFace != 0 && m_faceEntries[faceId] >= m_maxEntriesPerFace)
+    {
+      NS_LOG_DEBUG ("Face " << faceId << " has reached the limit of " << m_maxEntriesPerFace << " PIT entries");
+      return 0;
+    }
+
+  Ptr<pit::Entry> entry = Create (header);
+  if (entry != 0 && entry->m_faceId == pit::Entry::NO_FACE) // Create can return an already existing entry
+    {
+      entry->m_faceId = faceId;
+      m_faceEntries[faceId] ++;
+    }
+  return entry;
+}
+
+uint32_t
+Pit::GetFaceEntryCount (Ptr<const Face> face) const
+{
+  if (face->GetId () < m_faceEntries.size ())
+    return m_faceEntries[face->GetId ()];
+  else
+    return 0;
+}
+
+void
+Pit::ReleaseFaceEntry (pit::Entry &entry)
+{
+  if (entry.m_faceId == pit::Entry::NO_FACE)
+    return;
+
+  NS_ASSERT (entry.m_faceId < m_faceEntries.size () && m_faceEntries[entry.m_faceId] > 0);
+  m_faceEntries[entry.m_faceId] --;
+  entry.m_faceId = pit::Entry::NO_FACE;
+}
+
+bool
+Pit::IsDeadNonce (const Interest &header)
+{
+  if (m_deadNonces.GetLifetime ().IsZero ())
+    return false;
+
+  const Name &name = header.GetName ();
+  return m_deadNonces.Has (name.GetPrefixHash (name.size ()), header.GetNonce ());
+}
+
+const Time &
+Pit::GetDeadNonceLifetime () const
+{
+  return m_deadNonces.GetLifetime ();
+}
+
+void
+Pit::SetDeadNonceLifetime (const Time &lifetime)
+{
+  m_deadNonces.SetLifetime (lifetime);
+}
+
+void
+Pit::AddDeadNonces (std::size_t prefixHash, const pit::Entry &entry)
+{
+  if (m_deadNonces.GetLifetime ().IsZero ())
+    return;
+
+  BOOST_FOREACH (uint32_t nonce, entry.GetSeenNonces ())
+    {
+      m_deadNonces.Add (prefixHash, nonce);
+    }
+}
+
 } // namespace ndn
 } // namespace ns3
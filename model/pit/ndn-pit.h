@@ -26,6 +26,9 @@
 #include "ns3/event-id.h"
 
 #include "ndn-pit-entry.h"
+#include "ndn-pit-dead-nonce-list.h"
+
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -34,6 +37,7 @@ class L3Protocol;
 class Face;
 class ContentObject;
 class Interest;
+class PrefixView;
 
 typedef Interest InterestHeader;
 typedef ContentObject ContentObjectHeader;
@@ -70,7 +74,7 @@ public:
    *
    * Not that this call should be repeated enough times until it return 0.
    * This way all records with shorter or equal prefix as in content object will be found
-   * and satisfied.
+   * and satisfied.  FindAllMatches returns all such records at once.
    *
    * \param prefix Prefix for which to lookup the entry
    * \returns smart pointer to PIT entry. If record not found,
@@ -79,6 +83,19 @@ public:
   virtual Ptr<pit::Entry>
   Lookup (const ContentObject &header) = 0;
 
+  /**
+   * \brief Find all PIT entries that can be satisfied by the content object
+   *
+   * Unlike repeated Lookup (const ContentObject&) calls, all entries are collected during a single
+   * walk along the content name
+   *
+   * \param header parsed content object header
+   * \returns non-empty PIT entries, which names are prefixes of (or equal to) the content name,
+   *          starting from the longest one
+   */
+  virtual std::vector< Ptr<pit::Entry> >
+  FindAllMatches (const ContentObject &header) = 0;
+
   /**
    * \brief Find a PIT entry for the given content interest
    * \param header parsed interest header
@@ -97,6 +114,15 @@ public:
   virtual Ptr<pit::Entry>
   Find (const Name &prefix) = 0;
 
+  /**
+   * @brief Get PIT entry for the prefix view (exact match)
+   *
+   * @param prefix Prefix of a name (no copies of the name are made during lookup)
+   * @returns If entry is found, a valid iterator (Ptr<pit::Entry>) will be returned. Otherwise End () (==0)
+   */
+  virtual Ptr<pit::Entry>
+  Find (const PrefixView &prefix) = 0;
+
   /**
    * @brief Creates a PIT entry for the given interest
    * @param header parsed interest header
@@ -108,6 +134,19 @@ public:
   virtual Ptr<pit::Entry>
   Create (Ptr<const Interest> header) = 0;
 
+  /**
+   * @brief Creates a PIT entry for the interest received on the face, enforcing per-face quota
+   * @param header parsed interest header
+   * @param inFace face, on which the interest has been received (the entry is charged to this face)
+   * @returns iterator to Pit entry. If record could not be created (e.g., the face has already
+   *          MaxEntriesPerFace entries or Create (header) failed), return end() iterator
+   *
+   * Each face can have at most MaxEntriesPerFace entries, so a single face cannot fill the whole PIT.
+   * Entry is charged to the face until it is removed from the PIT
+   */
+  Ptr<pit::Entry>
+  Create (Ptr<const Interest> header, Ptr<Face> inFace);
+
   /**
    * @brief Mark PIT entry deleted
    * @param entry PIT entry
@@ -172,11 +211,61 @@ public:
   inline void
   SetMaxPitEntryLifetime (const Time &maxLifetime);
 
+  /**
+   * @brief Check if the Interest carries a nonce of a recently removed PIT entry for the same name
+   *
+   * Such Interest is a looping copy of the Interest that has been already satisfied (see DeadNonceLifetime
+   * attribute).  Nonces of timed out PIT entries are not remembered
+   */
+  bool
+  IsDeadNonce (const Interest &header);
+
+  /**
+   * @brief Get time for which nonces of the removed PIT entries are remembered
+   */
+  const Time &
+  GetDeadNonceLifetime () const;
+
+  /**
+   * @brief Set time for which nonces of the removed PIT entries are remembered (zero disables the dead nonce list)
+   */
+  void
+  SetDeadNonceLifetime (const Time &lifetime);
+
+  /**
+   * @brief Get number of existing PIT entries that are charged to the face (see Create (header, inFace))
+   */
+  uint32_t
+  GetFaceEntryCount (Ptr<const Face> face) const;
+
+protected:
+  /**
+   * @brief Remember nonces of the PIT entry that is being satisfied or erased (should be called by implementations in MarkErased)
+   * @param prefixHash hash of the PIT entry prefix (Name::GetPrefixHash of the whole name)
+   * @param entry PIT entry
+   */
+  void
+  AddDeadNonces (std::size_t prefixHash, const pit::Entry &entry);
+
+  /**
+   * @brief Release the charge of the PIT entry to its incoming face (should be called by implementations
+   *        when entry is removed from the PIT, no-op if entry is not charged)
+   */
+  void
+  ReleaseFaceEntry (pit::Entry &entry);
+
 protected:
   // configuration variables. Check implementation of GetTypeId for more details
   Time m_PitEntryPruningTimout;
 
   Time m_maxPitEntryLifetime;
+
+  pit::DeadNonceList m_deadNonces; ///< @brief nonces of recently removed PIT entries
+
+  uint32_t m_maxEntriesPerFace; ///< @brief Maximum number of entries charged to one face (0 if not limited)
+
+private:
+  std::vector<uint32_t> m_faceEntries; ///< @brief Number of entries charged to each face (indexed by face id)
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@
 #include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
+#include <vector>
 
 #include "ns3/ndn-fib-entry.h"
 
@@ -151,4 +152,91 @@ FibEntryTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (recorders.front ()->count, 2, "two events should have been reported");
 }
 
+void
+FibHashLpmTest::CheckMatch (Ptr<ndn::Fib> fib, const std::string &name, const std::string &prefix)
+{
+  ndn::Interest interest;
+  interest.SetName (Create<ndn::Name> (name));
+
+  Ptr<ndn::fib::Entry> entry = fib->LongestPrefixMatch (interest);
+  if (prefix.empty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (entry == 0, true, "There should be no match for " << name);
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (entry != 0, true, "There should be a match for " << name);
+      NS_TEST_ASSERT_MSG_EQ (entry->GetPrefix (), ndn::Name (prefix), "Wrong longest prefix match for " << name);
+    }
+}
+
+void
+FibHashLpmTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetFib ("ns3::ndn::fib::HashLpm");
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  Ptr<ndn::Face> face = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+
+  fib->Add (ndn::Name ("/a"), face, 0);
+  fib->Add (ndn::Name ("/a/b/c/d"), face, 0);
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 2, "Markers should not be counted as FIB entries");
+  NS_TEST_ASSERT_MSG_EQ (fib->Find (ndn::Name ("/a/b")) == 0, true, "Marker should not be found as FIB entry");
+
+  CheckMatch (fib, "/b", "");
+  CheckMatch (fib, "/a/x", "/a");
+  CheckMatch (fib, "/a/b/c/d/e", "/a/b/c/d");
+  // search hits markers of /a/b/c/d, but there is no longer match, best match linked to the marker is used
+  CheckMatch (fib, "/a/b/c/x", "/a");
+  CheckMatch (fib, "/a/b", "/a");
+
+  // markers under the added prefix are linked to it
+  fib->Add (ndn::Name ("/a/b"), face, 0);
+  CheckMatch (fib, "/a/b/c/x", "/a/b");
+
+  // longer prefix changes search range and all markers are placed again
+  fib->Add (ndn::Name ("/a/b/c/d/e/f/g/h"), face, 0);
+  CheckMatch (fib, "/a/b/c/d/e/f/g/h/i", "/a/b/c/d/e/f/g/h");
+  CheckMatch (fib, "/a/b/c/d/e/f", "/a/b/c/d");
+  CheckMatch (fib, "/a/b/c/x", "/a/b");
+
+  // removal of the longest prefix
+  fib->Remove (Create<ndn::Name> ("/a/b/c/d/e/f/g/h"));
+  CheckMatch (fib, "/a/b/c/d/e/f/g/h/i", "/a/b/c/d");
+
+  // markers of the removed prefix fall back to the next shorter prefix
+  fib->Remove (Create<ndn::Name> ("/a/b"));
+  CheckMatch (fib, "/a/b/c/x", "/a");
+
+  fib->Remove (Create<ndn::Name> ("/a/b/c/d"));
+  CheckMatch (fib, "/a/b/c/d/e", "/a");
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 1, "Only /a should remain");
+
+  fib->Remove (Create<ndn::Name> ("/a"));
+  CheckMatch (fib, "/a/b/c/d/e", "");
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 0, "FIB should be empty");
+
+  // bulk add gives the same result as adding routes one by one
+  std::vector<ndn::Fib::Route> routes;
+  routes.push_back (ndn::Fib::Route (Create<ndn::Name> ("/a/b/c/d"), face, 0));
+  routes.push_back (ndn::Fib::Route (Create<ndn::Name> ("/a"), face, 0));
+  routes.push_back (ndn::Fib::Route (Create<ndn::Name> ("/a/b/c/d/e/f"), face, 0));
+  routes.push_back (ndn::Fib::Route (Create<ndn::Name> ("/a"), face, 1));
+  fib->BulkAdd (routes);
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 3, "Duplicate route should update the existing entry");
+  CheckMatch (fib, "/a/b/c/x", "/a");
+  CheckMatch (fib, "/a/b/c/d/e", "/a/b/c/d");
+  CheckMatch (fib, "/a/b/c/d/e/f/g", "/a/b/c/d/e/f");
+
+  Simulator::Destroy ();
+}
+
 }
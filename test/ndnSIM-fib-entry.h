@@ -24,6 +24,8 @@
 #include "ns3/test.h"
 #include "ns3/ptr.h"
 
+#include <string>
+
 namespace ns3 {
 
 namespace ndn {
@@ -43,6 +45,20 @@ private:
   virtual void DoRun ();
 };
 
+class FibHashLpmTest : public TestCase
+{
+public:
+  FibHashLpmTest ()
+    : TestCase ("Hash LPM FIB test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckMatch (Ptr<ndn::Fib> fib, const std::string &name, const std::string &prefix);
+};
+
 }
 
 #endif // NDNSIM_TEST_FIB_ENTRY_H
@@ -0,0 +1,229 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-name.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <boost/lexical_cast.hpp>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.NameTest");
+
+void
+NameTest::CheckStorage ()
+{
+  ndn::Name name ("/x/yy/zzz");
+  NS_TEST_ASSERT_MSG_EQ (name.size (), 3, "Name should have 3 components");
+  NS_TEST_ASSERT_MSG_EQ (std::string (name.get (0)), "x", "Wrong first component");
+  NS_TEST_ASSERT_MSG_EQ (std::string (name.get (1)), "yy", "Wrong second component");
+  NS_TEST_ASSERT_MSG_EQ (std::string (name.get (2)), "zzz", "Wrong last component");
+  NS_TEST_ASSERT_MSG_EQ (name.GetLastComponent (), "zzz", "Wrong last component");
+
+  // storage grows when components are appended one by one
+  ndn::Name longName;
+  for (int i = 0; i < 100; i++)
+    {
+      longName (i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (longName.size (), 100, "Name should have 100 components");
+  for (int i = 0; i < 100; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (std::string (longName.get (i)), boost::lexical_cast<std::string> (i),
+                             "Component should survive storage reallocations");
+    }
+
+  std::list<std::string> components = name.GetSubComponents (2);
+  NS_TEST_ASSERT_MSG_EQ (components.size (), 2, "Two components should be returned");
+  NS_TEST_ASSERT_MSG_EQ (components.back (), "yy", "Wrong second component");
+
+  NS_TEST_ASSERT_MSG_EQ (name.cut (1), ndn::Name ("/x/yy"), "Wrong prefix");
+  NS_TEST_ASSERT_MSG_EQ (name.cut (1) == ndn::Name ("/x/yz"), false, "Names with different components should not be equal");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("/x/yy") < ndn::Name ("/x/yz"), true, "Names should be compared component-wise");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("/x") < ndn::Name ("/x/yy"), true, "Prefix should be less than the name");
+}
+
+void
+NameTest::CheckCopyOnWrite ()
+{
+  ndn::Name name ("/x/yy/zzz");
+
+  // prefix shares storage with the name, appending to it should not change the name
+  ndn::Name prefix = name.cut (1);
+  prefix ("q");
+  NS_TEST_ASSERT_MSG_EQ (prefix, ndn::Name ("/x/yy/q"), "Component should be appended to the prefix");
+  NS_TEST_ASSERT_MSG_EQ (name, ndn::Name ("/x/yy/zzz"), "Original name should not change");
+
+  ndn::Name copy (name);
+  copy ("w");
+  NS_TEST_ASSERT_MSG_EQ (copy.size (), 4, "Component should be appended to the copy");
+  NS_TEST_ASSERT_MSG_EQ (name.size (), 3, "Original name should not change");
+
+  // appending component of the name to itself
+  ndn::Name self ("/a");
+  self.Add (self.get (0));
+  NS_TEST_ASSERT_MSG_EQ (self, ndn::Name ("/a/a"), "Component of the name should be appended to itself");
+}
+
+void
+NameTest::CheckDeserialize ()
+{
+  ndn::Name name ("/x/yy/zzz");
+  Buffer buffer;
+  buffer.AddAtStart (name.GetSerializedSize ());
+  name.Serialize (buffer.Begin ());
+
+  ndn::Name result;
+  NS_TEST_ASSERT_MSG_EQ (result.Deserialize (buffer.Begin ()), name.GetSerializedSize (), "Whole name should be read");
+  NS_TEST_ASSERT_MSG_EQ (result, name, "Name should survive serialization");
+
+  // component length exceeds the name length
+  Buffer malformed;
+  malformed.AddAtStart (6);
+  Buffer::Iterator i = malformed.Begin ();
+  i.WriteU16 (4);
+  i.WriteU16 (10);
+  i.WriteU16 (0);
+
+  bool thrown = false;
+  try
+    {
+      ndn::Name bad;
+      bad.Deserialize (malformed.Begin ());
+    }
+  catch (ndn::NameException)
+    {
+      thrown = true;
+    }
+  NS_TEST_ASSERT_MSG_EQ (thrown, true, "Malformed component length should be rejected");
+
+  // trailing byte that cannot hold the component length
+  malformed.Begin ().WriteU16 (1);
+  thrown = false;
+  try
+    {
+      ndn::Name bad;
+      bad.Deserialize (malformed.Begin ());
+    }
+  catch (ndn::NameException)
+    {
+      thrown = true;
+    }
+  NS_TEST_ASSERT_MSG_EQ (thrown, true, "Truncated component length should be rejected");
+}
+
+void
+NameTest::CheckPrefixHash ()
+{
+  ndn::Name name ("/a/b/c");
+  ndn::Name other;
+  other ("a") ("b") ("c");
+
+  NS_TEST_ASSERT_MSG_EQ (name.GetPrefixHash (3), other.GetPrefixHash (3), "Equal names should have equal hashes");
+  NS_TEST_ASSERT_MSG_EQ (name.GetPrefixHash (2) != name.GetPrefixHash (3), true, "Prefixes should have different hashes");
+  NS_TEST_ASSERT_MSG_EQ (name.GetPrefixHash (2), ndn::Name ("/a/b").GetPrefixHash (2), "Hash should depend only on the prefix");
+
+  // hashes cached in the shared storage should stay valid after the prefix is extended
+  ndn::Name prefix = name.cut (1);
+  size_t hash = prefix.GetPrefixHash (2);
+  prefix ("zz");
+  NS_TEST_ASSERT_MSG_EQ (prefix.GetPrefixHash (2), hash, "Hash of the prefix should not change");
+  NS_TEST_ASSERT_MSG_EQ (prefix.GetPrefixHash (3), ndn::Name ("/a/b/zz").GetPrefixHash (3), "Hash of the new component should be recalculated");
+  NS_TEST_ASSERT_MSG_EQ (name.GetPrefixHash (3), other.GetPrefixHash (3), "Hash of the original name should not change");
+
+  ndn::PrefixView view (name, 2);
+  NS_TEST_ASSERT_MSG_EQ (view.size (), 2, "View should contain 2 components");
+  NS_TEST_ASSERT_MSG_EQ (view.GetPrefixHash (2), name.GetPrefixHash (2), "View should use hashes of the name");
+  NS_TEST_ASSERT_MSG_EQ (view.ToName (), ndn::Name ("/a/b"), "View should be converted to the prefix");
+}
+
+void
+NameTest::CheckSeqNum ()
+{
+  ndn::Name name ("/prefix");
+  ndn::Name seq (name);
+  seq.AppendSeqNum (0x01020304);
+
+  NS_TEST_ASSERT_MSG_EQ (seq.HasSeqNum (), true, "Sequence number should be detected");
+  NS_TEST_ASSERT_MSG_EQ (seq.GetLastSeqNum (), 0x01020304, "Wrong sequence number");
+  NS_TEST_ASSERT_MSG_EQ (seq.get (1).size (), 5, "Sequence number component should contain marker and 4 bytes");
+  NS_TEST_ASSERT_MSG_EQ (name.HasSeqNum (), false, "Name without sequence number should not be detected");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("/prefix/5").HasSeqNum (), false, "Text component should not be detected");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ().HasSeqNum (), false, "Empty name has no sequence number");
+
+  ndn::Name max;
+  max.AppendSeqNum (4294967295u);
+  NS_TEST_ASSERT_MSG_EQ (max.GetLastSeqNum (), 4294967295u, "Maximum sequence number should be preserved");
+
+  // sequence number should survive serialization
+  Buffer buffer;
+  buffer.AddAtStart (seq.GetSerializedSize ());
+  seq.Serialize (buffer.Begin ());
+  ndn::Name result;
+  result.Deserialize (buffer.Begin ());
+  NS_TEST_ASSERT_MSG_EQ (result.HasSeqNum (), true, "Sequence number should be detected after deserialization");
+  NS_TEST_ASSERT_MSG_EQ (result.GetLastSeqNum (), 0x01020304, "Wrong sequence number after deserialization");
+}
+
+void
+NameTest::CheckUri ()
+{
+  ndn::Name name ("/a/bb//c/");
+  NS_TEST_ASSERT_MSG_EQ (name.size (), 3, "Empty components should be skipped");
+  NS_TEST_ASSERT_MSG_EQ (std::string (name.get (1)), "bb", "Wrong second component");
+
+  ndn::Name escaped ("ndn:/x%2Fy/%FE%00%00%00%07");
+  NS_TEST_ASSERT_MSG_EQ (escaped.size (), 2, "Escaped slash should not split the component");
+  NS_TEST_ASSERT_MSG_EQ (std::string (escaped.get (0)), "x/y", "Escaped slash should be decoded");
+  NS_TEST_ASSERT_MSG_EQ (escaped.GetLastSeqNum (), 7, "Binary component should be decoded");
+
+  ndn::Name spaces (" / a b / c ");
+  NS_TEST_ASSERT_MSG_EQ (spaces.size (), 2, "Whitespace should be ignored");
+  NS_TEST_ASSERT_MSG_EQ (std::string (spaces.get (0)), "ab", "Whitespace inside the component should be ignored");
+
+  NS_TEST_ASSERT_MSG_EQ (std::string (ndn::Name ("/%4").get (0)), "%4", "Incomplete escape should be kept as is");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("/").size (), 0, "Root name should be empty");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("").size (), 0, "Empty string should give an empty name");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("/p/q/zz", 4).size (), 2, "Only the specified length should be parsed");
+
+  std::istringstream is ("/q/w");
+  ndn::Name read ("/pre");
+  is >> read;
+  NS_TEST_ASSERT_MSG_EQ (read, ndn::Name ("/pre/q/w"), "Components should be appended by operator>>");
+
+  // printed name should be parsed back to the same name
+  std::ostringstream os;
+  os << escaped;
+  NS_TEST_ASSERT_MSG_EQ (os.str (), "/x%2Fy/%FE%00%00%00%07", "Special and binary bytes should be escaped");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name (os.str ()), escaped, "Printed name should be parsed back");
+}
+
+void
+NameTest::DoRun ()
+{
+  CheckStorage ();
+  CheckCopyOnWrite ();
+  CheckDeserialize ();
+  CheckPrefixHash ();
+  CheckSeqNum ();
+  CheckUri ();
+}
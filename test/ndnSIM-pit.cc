@@ -23,7 +23,13 @@
 #include "ns3/ndnSIM-module.h"
 #include "ns3/point-to-point-module.h"
 
+#include "../model/pit/ndn-pit-timer-wheel.h"
+#include "../model/pit/ndn-pit-entry-containers.h"
+#include "../model/pit/ndn-pit-dead-nonce-list.h"
+#include "../model/fw/ndn-fw-tag.h"
+
 #include <boost/lexical_cast.hpp>
+#include <vector>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.PitTest");
 
@@ -142,4 +148,430 @@ PitTest::DoRun ()
   Simulator::Destroy ();
 }
 
+namespace {
+
+struct TimerItem
+{
+  Time m_expireTime;
+  bool m_expired;
+  ndn::pit::TimerWheelHook m_hook;
+
+  const Time &
+  GetExpireTime () const
+  {
+    return m_expireTime;
+  }
+};
+
+typedef ndn::pit::TimerWheel<TimerItem, &TimerItem::m_hook> TestTimerWheel;
+
+int g_liveTags = 0;
+
+template<int Id, size_t Size>
+class TestTag : public ndn::fw::Tag
+{
+public:
+  TestTag () : m_value (Id) { g_liveTags ++; }
+  virtual ~TestTag () { g_liveTags --; }
+
+  int m_value;
+  char m_padding [Size];
+};
+
+typedef TestTag<1, 1> SmallTag;     // stored inside the slot
+typedef TestTag<2, 64> BigTag;      // allocated on heap
+typedef TestTag<3, 1> OtherTag;
+typedef TestTag<4, 1> FourthTag;
+typedef TestTag<5, 1> FifthTag;     // five tags need more than one block of slots
+
+Ptr<ndn::pit::Entry>
+CreateEntry (Ptr<ndn::Pit> pit, const std::string &name, Ptr<ndn::Face> face)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (name));
+  interest->SetInterestLifetime (Seconds (10.0));
+
+  Ptr<ndn::pit::Entry> entry = pit->Create (interest);
+  if (entry != 0 && face != 0)
+    entry->AddIncoming (face);
+  return entry;
+}
+
+}
+
+void
+PitFindAllMatchesTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+  Ptr<ndn::Face> face = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+
+  CreateEntry (pit, "/a", face);
+  CreateEntry (pit, "/a/b", 0); // entry without incoming faces cannot be satisfied
+  CreateEntry (pit, "/a/b/c", face);
+  CreateEntry (pit, "/a/x", face);
+  CreateEntry (pit, "/a/b/c/d/e", face);
+
+  ndn::ContentObject data;
+  data.SetName (Create<ndn::Name> ("/a/b/c/d"));
+
+  std::vector< Ptr<ndn::pit::Entry> > matches = pit->FindAllMatches (data);
+  NS_TEST_ASSERT_MSG_EQ (matches.size (), 2, "Only /a/b/c and /a should match");
+  NS_TEST_ASSERT_MSG_EQ (matches[0]->GetPrefix (), ndn::Name ("/a/b/c"), "The longest prefix should be the first");
+  NS_TEST_ASSERT_MSG_EQ (matches[1]->GetPrefix (), ndn::Name ("/a"), "The shortest prefix should be the last");
+
+  // the same entries in the same order as with repeated Lookup calls
+  for (size_t i = 0; i < matches.size (); i++)
+    {
+      Ptr<ndn::pit::Entry> entry = pit->Lookup (data);
+      NS_TEST_ASSERT_MSG_EQ (entry, matches[i], "Lookup should return the same entry");
+      entry->ClearIncoming ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (pit->Lookup (data) == 0, true, "All entries should be satisfied");
+  NS_TEST_ASSERT_MSG_EQ (pit->FindAllMatches (data).empty (), true, "Satisfied entries should not match");
+
+  Simulator::Destroy ();
+}
+
+void
+TimerWheelTest::DoRun ()
+{
+  TestTimerWheel wheel; // ticks of 1ms, blocks of 1024 ticks, overflow list after 1024 blocks
+
+  // first block, block boundaries, several blocks ahead, overflow list (including more than one round of blocks)
+  const uint64_t expireTimes[] = { 0, 1000, 7300, 1023000, 1024000, 1025000, 2047500, 5000000,
+                                   1048575000, 1048576000, 2000000000 }; // microseconds
+
+  std::vector<TimerItem> items (sizeof (expireTimes) / sizeof (expireTimes[0]));
+  for (size_t i = 0; i < items.size (); i++)
+    {
+      items[i].m_expireTime = MicroSeconds (expireTimes[i]);
+      items[i].m_expired = false;
+      wheel.Insert (items[i]);
+    }
+
+  TimerItem erased;
+  erased.m_expireTime = MilliSeconds (1500);
+  erased.m_expired = false;
+  wheel.Insert (erased);
+  wheel.Erase (erased);
+
+  // jump from deadline to deadline, as PIT does
+  Time now;
+  Time deadline;
+  size_t expired = 0;
+  while (wheel.GetNextDeadline (deadline))
+    {
+      NS_TEST_ASSERT_MSG_EQ (now <= deadline, true, "Deadline should not go back in time");
+      now = deadline;
+
+      TestTimerWheel::item_list list;
+      wheel.Advance (now, list);
+      NS_TEST_ASSERT_MSG_EQ (list.empty (), false, "Something should expire at the deadline");
+
+      while (!list.empty ())
+        {
+          TimerItem &item = list.front ();
+          list.pop_front ();
+          NS_TEST_ASSERT_MSG_EQ (item.m_expireTime <= now, true, "Item should not expire early");
+          NS_TEST_ASSERT_MSG_EQ (now - item.m_expireTime < MilliSeconds (1), true, "Item should expire within one tick");
+          NS_TEST_ASSERT_MSG_EQ (item.m_expired, false, "Item should expire only once");
+          item.m_expired = true;
+          expired ++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (expired, items.size (), "All items should expire");
+  NS_TEST_ASSERT_MSG_EQ (erased.m_expired, false, "Erased item should not expire");
+
+  // cursor is now in the middle of a block, so slots of the following blocks wrap around
+  Time start = now;
+  const uint32_t offsets[] = { 1, 100, 1023, 1024, 200000, 1000000, 1048576, 1100000 }; // milliseconds
+
+  std::vector<TimerItem> laterItems (sizeof (offsets) / sizeof (offsets[0]));
+  for (size_t i = 0; i < laterItems.size (); i++)
+    {
+      laterItems[i].m_expireTime = start + MilliSeconds (offsets[i]);
+      laterItems[i].m_expired = false;
+      wheel.Insert (laterItems[i]);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (wheel.GetNextDeadline (deadline), true, "Wheel should not be empty");
+  NS_TEST_ASSERT_MSG_EQ (deadline, start + MilliSeconds (1), "Deadline should be the nearest expiration");
+
+  // advance in steps of many ticks
+  expired = 0;
+  for (Time previous = start; previous < start + MilliSeconds (offsets[laterItems.size () - 1]); previous = now)
+    {
+      now = previous + Seconds (1.0);
+
+      TestTimerWheel::item_list list;
+      wheel.Advance (now, list);
+      while (!list.empty ())
+        {
+          TimerItem &item = list.front ();
+          list.pop_front ();
+          NS_TEST_ASSERT_MSG_EQ (previous < item.m_expireTime && item.m_expireTime <= now, true,
+                                 "Item should expire in the step, which contains its expiration time");
+          item.m_expired = true;
+          expired ++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (expired, laterItems.size (), "All items should expire");
+  NS_TEST_ASSERT_MSG_EQ (wheel.GetNextDeadline (deadline), false, "Wheel should be empty");
+}
+
+void
+PitEntryContainersTest::DoRun ()
+{
+  // nonces stay in the container after inline storage is exhausted
+  ndn::pit::NonceContainer<4> nonces;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      nonces.insert (i * 7);
+    }
+  nonces.insert (7);
+  NS_TEST_ASSERT_MSG_EQ (nonces.size (), 100, "Duplicate nonce should not be added");
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (nonces.find (i * 7) != nonces.end (), true, "No nonce should be forgotten");
+      NS_TEST_ASSERT_MSG_EQ (nonces.begin ()[i], i * 7, "Nonces should be kept in the order they were added");
+    }
+  NS_TEST_ASSERT_MSG_EQ (nonces.find (1) == nonces.end (), true, "Unknown nonce should not be found");
+
+  ndn::pit::NonceContainer<4> copy (nonces);
+  nonces.clear ();
+  NS_TEST_ASSERT_MSG_EQ (nonces.empty (), true, "Container should be empty after clear");
+  NS_TEST_ASSERT_MSG_EQ (copy.size (), 100, "Copy should keep all nonces");
+  NS_TEST_ASSERT_MSG_EQ (copy.find (693) != copy.end (), true, "Copy should keep nonces from the heap");
+
+  // faces are kept ordered as in std::set
+  Ptr<Node> node = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  for (int i = 0; i < 3; i++)
+    {
+      p2p.Install (node, CreateObject<Node> ());
+    }
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+
+  Ptr<ndn::L3Protocol> ndnProtocol = node->GetObject<ndn::L3Protocol> ();
+  NS_TEST_ASSERT_MSG_EQ (ndnProtocol->GetNFaces (), 3, "Node should have 3 faces");
+
+  typedef ndn::pit::FaceContainer<ndn::pit::IncomingFace, 2> in_container;
+  in_container faces;
+  for (int i = 2; i >= 0; i--)
+    {
+      std::pair<in_container::iterator, bool> result = faces.insert (ndn::pit::IncomingFace (ndnProtocol->GetFace (i)));
+      NS_TEST_ASSERT_MSG_EQ (result.second, true, "Record should be inserted");
+      NS_TEST_ASSERT_MSG_EQ (result.first->m_face, ndnProtocol->GetFace (i), "Inserted record should be returned");
+    }
+  NS_TEST_ASSERT_MSG_EQ (faces.insert (ndn::pit::IncomingFace (ndnProtocol->GetFace (1))).second, false,
+                         "Second record for the same face should not be inserted");
+  NS_TEST_ASSERT_MSG_EQ (faces.size (), 3, "Container should grow beyond inline capacity");
+
+  for (in_container::iterator face = faces.begin (); face + 1 != faces.end (); face++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (*face < *(face + 1), true, "Records should be ordered by face");
+    }
+
+  in_container copyFaces (faces);
+  NS_TEST_ASSERT_MSG_EQ (faces.erase (ndnProtocol->GetFace (1)), 1, "Record should be erased");
+  NS_TEST_ASSERT_MSG_EQ (faces.erase (ndnProtocol->GetFace (1)), 0, "Record should be erased only once");
+  NS_TEST_ASSERT_MSG_EQ (faces.find (ndnProtocol->GetFace (1)) == faces.end (), true, "Erased record should not be found");
+  NS_TEST_ASSERT_MSG_EQ (faces.find (ndnProtocol->GetFace (2)) != faces.end (), true, "Other records should stay");
+  NS_TEST_ASSERT_MSG_EQ (copyFaces.size (), 3, "Copy should not be affected");
+
+  faces.clear ();
+  NS_TEST_ASSERT_MSG_EQ (faces.empty (), true, "Container should be empty after clear");
+
+  Simulator::Destroy ();
+}
+
+void
+FwTagSlotsTest::DoRun ()
+{
+  NS_TEST_ASSERT_MSG_EQ (ndn::fw::TagSlots::GetSlot<SmallTag> () != ndn::fw::TagSlots::GetSlot<BigTag> (), true,
+                         "Each tag class should have its own slot");
+  NS_TEST_ASSERT_MSG_EQ (ndn::fw::TagSlots::GetSlot<SmallTag> (), ndn::fw::TagSlots::GetSlot<SmallTag> (),
+                         "Slot of the tag class should not change");
+
+  {
+    ndn::fw::TagSlots tags;
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<SmallTag> () == 0, true, "There should be no tags in the new container");
+
+    tags.GetOrCreate<SmallTag> ().m_value = 10;
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<SmallTag> ()->m_value, 10, "Tag should be created once");
+    NS_TEST_ASSERT_MSG_EQ (tags.GetOrCreate<SmallTag> ().m_value, 10, "Existing tag should be returned");
+
+    tags.GetOrCreate<FifthTag> ();
+    tags.GetOrCreate<BigTag> ();
+    tags.GetOrCreate<OtherTag> ();
+    tags.GetOrCreate<FourthTag> ();
+    NS_TEST_ASSERT_MSG_EQ (g_liveTags, 5, "All tags should be created");
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<BigTag> ()->m_value, 2, "Heap tag should be found");
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<FifthTag> ()->m_value, 5, "Tag in the next block should be found");
+
+    tags.Remove<BigTag> ();
+    tags.Remove<FifthTag> ();
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<BigTag> () == 0, true, "Removed tag should not be found");
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<FifthTag> () == 0, true, "Removed tag should not be found");
+    NS_TEST_ASSERT_MSG_EQ (g_liveTags, 3, "Removed tags should be destroyed");
+
+    // tags are not copied
+    ndn::fw::TagSlots copy (tags);
+    NS_TEST_ASSERT_MSG_EQ (copy.Get<SmallTag> () == 0, true, "Tags should not be copied");
+
+    tags.Clear ();
+    NS_TEST_ASSERT_MSG_EQ (g_liveTags, 0, "All tags should be destroyed on clear");
+    NS_TEST_ASSERT_MSG_EQ (tags.Get<SmallTag> () == 0, true, "There should be no tags after clear");
+
+    tags.GetOrCreate<BigTag> ();
+    tags.GetOrCreate<SmallTag> ();
+  }
+  NS_TEST_ASSERT_MSG_EQ (g_liveTags, 0, "All tags should be destroyed with the container");
+}
+
+void
+PitHashExactTest::CheckSize (Ptr<ndn::Pit> pit, uint32_t size)
+{
+  NS_TEST_ASSERT_MSG_EQ (pit->GetSize (), size, "Unexpected number of entries in PIT");
+}
+
+void
+PitHashExactTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> nodeSink = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, nodeSink);
+
+  ndn::StackHelper ndn;
+  ndn.SetPit ("ns3::ndn::pit::HashExact");
+  ndn.Install (node);
+  ndn.Install (nodeSink);
+
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  Ptr<ndn::Pit> pit = node->GetObject<ndn::Pit> ();
+  Ptr<ndn::Face> face = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+
+  // enough entries for several rehashes of the table
+  for (int i = 0; i < 200; i++)
+    {
+      Ptr<ndn::pit::Entry> entry = CreateEntry (pit, "/x/" + boost::lexical_cast<std::string> (i), face);
+      NS_TEST_ASSERT_MSG_EQ (entry != 0, true, "PIT entry should be created");
+    }
+  CheckSize (pit, 200);
+
+  // erase every third entry.  Erasure shifts the following entries backward, so entries are collected
+  // first and erased after the iteration is finished
+  std::vector< Ptr<ndn::pit::Entry> > toErase;
+  for (Ptr<ndn::pit::Entry> entry = pit->Begin (); entry != pit->End (); entry = pit->Next (entry))
+    {
+      if (boost::lexical_cast<int> (std::string (entry->GetPrefix ().get (1))) % 3 == 0)
+        toErase.push_back (entry);
+    }
+  NS_TEST_ASSERT_MSG_EQ (toErase.size (), 67, "Iteration should visit all entries");
+  for (std::vector< Ptr<ndn::pit::Entry> >::iterator entry = toErase.begin (); entry != toErase.end (); entry++)
+    {
+      pit->MarkErased (*entry);
+    }
+  CheckSize (pit, 133);
+
+  uint32_t count = 0;
+  for (Ptr<ndn::pit::Entry> entry = pit->Begin (); entry != pit->End (); entry = pit->Next (entry))
+    {
+      count ++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (count, 133, "Iteration should visit all remaining entries");
+
+  for (int i = 0; i < 200; i++)
+    {
+      bool found = pit->Find (ndn::Name ("/x/" + boost::lexical_cast<std::string> (i))) != 0;
+      NS_TEST_ASSERT_MSG_EQ (found, i % 3 != 0, "Only erased entries should be missing");
+    }
+
+  // Data is matched to the longest prefix, and to the shorter one after the longest is removed
+  CreateEntry (pit, "/y", face);
+  CreateEntry (pit, "/y/z/w", face);
+
+  ndn::ContentObject data;
+  data.SetName (Create<ndn::Name> ("/y/z/w/1"));
+  NS_TEST_ASSERT_MSG_EQ (pit->FindAllMatches (data).size (), 2, "Both /y and /y/z/w should match");
+
+  Ptr<ndn::pit::Entry> match = pit->Lookup (data);
+  NS_TEST_ASSERT_MSG_EQ (match != 0, true, "PIT entry should be found");
+  NS_TEST_ASSERT_MSG_EQ (match->GetPrefix (), ndn::Name ("/y/z/w"), "The longest prefix should match");
+
+  pit->MarkErased (match);
+  match = pit->Lookup (data);
+  NS_TEST_ASSERT_MSG_EQ (match != 0, true, "PIT entry should be found");
+  NS_TEST_ASSERT_MSG_EQ (match->GetPrefix (), ndn::Name ("/y"), "/y should match after /y/z/w is removed");
+
+  // the remaining entries are removed by the timer wheel when their lifetime is over
+  Simulator::Schedule (Seconds (9.9), &PitHashExactTest::CheckSize, this, pit, 134);
+  Simulator::Schedule (Seconds (10.1), &PitHashExactTest::CheckSize, this, pit, 0);
+
+  Simulator::Stop (Seconds (11.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+DeadNonceListTest::CheckHas (ndn::pit::DeadNonceList *list, std::size_t prefixHash, uint32_t nonce, bool expected)
+{
+  NS_TEST_ASSERT_MSG_EQ (list->Has (prefixHash, nonce), expected,
+                         "Unexpected dead nonce lookup result at " << Simulator::Now ().ToDouble (Time::S) << "s");
+}
+
+void
+DeadNonceListTest::DoRun ()
+{
+  std::size_t hash = ndn::Name ("/a/b").GetPrefixHash (2);
+  std::size_t otherHash = ndn::Name ("/a/c").GetPrefixHash (2);
+
+  ndn::pit::DeadNonceList list;
+  list.Add (hash, 1);
+  NS_TEST_ASSERT_MSG_EQ (list.size (), 0, "List should be disabled by default");
+  NS_TEST_ASSERT_MSG_EQ (list.Has (hash, 1), false, "Nothing should be recorded while the list is disabled");
+
+  list.SetLifetime (Seconds (1.0));
+  list.Add (hash, 1);
+  list.Add (hash, 2);
+  NS_TEST_ASSERT_MSG_EQ (list.Has (hash, 1), true, "Recorded nonce should be found");
+  NS_TEST_ASSERT_MSG_EQ (list.Has (hash, 3), false, "Other nonce should not be found");
+  NS_TEST_ASSERT_MSG_EQ (list.Has (otherHash, 1), false, "Nonce of other prefix should not be found");
+
+  // the same nonce is recorded again later and should be kept until the later record expires
+  Simulator::Schedule (Seconds (0.5), &ndn::pit::DeadNonceList::Add, &list, hash, 1);
+
+  Simulator::Schedule (Seconds (0.9), &DeadNonceListTest::CheckHas, this, &list, hash, 2, true);
+  Simulator::Schedule (Seconds (1.1), &DeadNonceListTest::CheckHas, this, &list, hash, 2, false);
+  Simulator::Schedule (Seconds (1.2), &DeadNonceListTest::CheckHas, this, &list, hash, 1, true);
+  Simulator::Schedule (Seconds (1.6), &DeadNonceListTest::CheckHas, this, &list, hash, 1, false);
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (list.size (), 0, "Expired records should be removed");
+
+  list.Add (hash, 4);
+  list.SetLifetime (Seconds (0));
+  NS_TEST_ASSERT_MSG_EQ (list.size (), 0, "Records should be removed when the list is disabled");
+  NS_TEST_ASSERT_MSG_EQ (list.Has (hash, 4), false, "Nothing should be found when the list is disabled");
+
+  Simulator::Destroy ();
+}
+
 }
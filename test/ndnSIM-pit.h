@@ -29,6 +29,9 @@ namespace ns3 {
 namespace ndn {
 class Fib;
 class Pit;
+namespace pit {
+class DeadNonceList;
+}
 }
   
 class PitTest : public TestCase
@@ -48,6 +51,82 @@ private:
   void Check2 (Ptr<ndn::Pit> pit);
   void Check3 (Ptr<ndn::Pit> pit);
 };
+
+class PitFindAllMatchesTest : public TestCase
+{
+public:
+  PitFindAllMatchesTest ()
+    : TestCase ("PIT multi-entry match test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class TimerWheelTest : public TestCase
+{
+public:
+  TimerWheelTest ()
+    : TestCase ("PIT timer wheel test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class PitEntryContainersTest : public TestCase
+{
+public:
+  PitEntryContainersTest ()
+    : TestCase ("PIT entry face and nonce containers test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class FwTagSlotsTest : public TestCase
+{
+public:
+  FwTagSlotsTest ()
+    : TestCase ("Forwarding strategy tag slots test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+class PitHashExactTest : public TestCase
+{
+public:
+  PitHashExactTest ()
+    : TestCase ("Hash PIT test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckSize (Ptr<ndn::Pit> pit, uint32_t size);
+};
+
+class DeadNonceListTest : public TestCase
+{
+public:
+  DeadNonceListTest ()
+    : TestCase ("PIT dead nonce list test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckHas (ndn::pit::DeadNonceList *list, std::size_t prefixHash, uint32_t nonce, bool expected);
+};
   
 }
 
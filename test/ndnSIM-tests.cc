@@ -24,6 +24,8 @@
 #include "ndnSIM-serialization.h"
 #include "ndnSIM-pit.h"
 #include "ndnSIM-fib-entry.h"
+#include "ndnSIM-name.h"
+#include "ndnSIM-trie.h"
 
 namespace ns3
 {
@@ -36,10 +38,19 @@ public:
   {
     SetDataDir (NS_TEST_SOURCEDIR);
 
+    AddTestCase (new NameTest ());
     AddTestCase (new InterestSerializationTest ());
     AddTestCase (new ContentObjectSerializationTest ());
     AddTestCase (new FibEntryTest ());
+    AddTestCase (new FibHashLpmTest ());
     // AddTestCase (new PitTest ());
+    AddTestCase (new PitFindAllMatchesTest ());
+    AddTestCase (new TimerWheelTest ());
+    AddTestCase (new PitEntryContainersTest ());
+    AddTestCase (new FwTagSlotsTest ());
+    AddTestCase (new PitHashExactTest ());
+    AddTestCase (new DeadNonceListTest ());
+    AddTestCase (new TrieTest ());
   }
 };
 
@@ -24,122 +24,550 @@
 #include "ndnSIM-trie.h"
 
 #include "../utils/trie/trie-with-policy.h"
+#include "../utils/trie/radix-trie.h"
 #include "../utils/trie/lru-policy.h"
 #include "../utils/trie/random-policy.h"
-#include "../utils/trie/fifo-policy.h"
-#include "../utils/trie/multi-policy.h"
+#include "../utils/trie/lfu-bucket-policy.h"
+#include "../utils/trie/arc-policy.h"
+#include "../utils/trie/tinylfu-policy.h"
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 using namespace ns3;
 using namespace ndn::ndnSIM;
-using namespace boost;
 
 NS_LOG_COMPONENT_DEFINE ("ndn.Trie");
 
-// class Integer : public ns3::SimpleRefCount<Integer>
-// {
-// public:
-//   ::Integer (int value) : value_ (value) {}
+namespace {
 
-//   operator int () const { return value_; }
-// private:
-//   int value_;
-// };
+class TestPayload : public SimpleRefCount<TestPayload>
+{
+public:
+  TestPayload (const ndn::Name &name, int value)
+    : m_name (name)
+    , m_value (value)
+  {
+  }
+
+  // required by ARC policy
+  const ndn::Name &
+  GetName () const
+  {
+    return m_name;
+  }
+
+  int
+  GetValue () const
+  {
+    return m_value;
+  }
+
+private:
+  ndn::Name m_name;
+  int m_value;
+};
+
+struct ChildNode
+{
+  size_t hash;
+};
+
+struct IsChild
+{
+  IsChild (const ChildNode *child) : m_child (child) { }
+
+  bool
+  operator() (const ChildNode &child) const
+  {
+    return &child == m_child;
+  }
+
+  const ChildNode *m_child;
+};
+
+struct HasValue
+{
+  HasValue (int value) : m_value (value) { }
+
+  bool
+  operator() (const Ptr<TestPayload> &payload) const
+  {
+    return payload->GetValue () == m_value;
+  }
+
+  int m_value;
+};
+
+struct CountingDisposer
+{
+  CountingDisposer (size_t &count) : m_count (&count) { }
+
+  void
+  operator() (ChildNode *) { (*m_count) ++; }
 
-// std::ostream &
-// operator << (std::ostream &os, const ::Integer &i)
-// {
-//   os << (int)i;
-//   return os;
-// }
+  size_t *m_count;
+};
 
+typedef trie_with_policy< ndn::Name,
+                          smart_pointer_payload_traits<TestPayload>,
+                          lru_policy_traits > lru_trie;
+
+typedef trie_with_policy< ndn::Name,
+                          smart_pointer_payload_traits<TestPayload>,
+                          lru_policy_traits,
+                          component_key_traits<ndn::Name>,
+                          heap_allocator,
+                          radix_trie > radix_lru_trie;
+
+typedef trie_with_policy< ndn::Name,
+                          smart_pointer_payload_traits<TestPayload>,
+                          random_policy_traits > random_trie;
+
+typedef trie_with_policy< ndn::Name,
+                          smart_pointer_payload_traits<TestPayload>,
+                          lfu_bucket_policy_traits > lfu_bucket_trie;
+
+typedef trie_with_policy< ndn::Name,
+                          smart_pointer_payload_traits<TestPayload>,
+                          arc_policy_traits > arc_trie;
+
+typedef trie_with_policy< ndn::Name,
+                          smart_pointer_payload_traits<TestPayload>,
+                          tinylfu_admission_traits<lru_policy_traits> > tinylfu_trie;
+
+template<class Trie>
+size_t
+CountNodes (Trie &trie)
+{
+  size_t count = 0;
+  typename Trie::parent_trie::recursive_iterator node (trie.getTrie ()), end (0);
+  for (; node != end; node++)
+    count ++;
+  return count;
+}
+
+template<class Trie>
 void
-TrieTest::DoRun ()
+Insert (Trie &trie, const std::string &name, int value)
+{
+  ndn::Name prefix (name);
+  trie.insert (prefix, Create<TestPayload> (prefix, value));
+}
+
+template<class Trie>
+int
+LongestPrefixMatch (Trie &trie, const std::string &name)
+{
+  typename Trie::iterator item = trie.longest_prefix_match (ndn::Name (name));
+  if (item == trie.end ())
+    return -1;
+  return item->payload ()->GetValue ();
+}
+
+template<class Trie>
+size_t
+SubtreeSize (Trie &trie, const std::string &name)
 {
-  cerr << "TrieTest is temporarily broken" << endl;
-  // typedef trie_with_policy<
-  //   ns3::NdnName,
-  //   smart_pointer_payload_traits<Integer>,
-  //   multi_policy_traits<
-  //     mpl::vector2<lru_policy_traits,random_policy_traits>
-  //     > > trie;
-  
-  // trie x;
-  // x.getPolicy ().get<0> ().set_max_size (100);
-  // x.getPolicy ().get<1> ().set_max_size (3);
-  // // // x.getPolicy ().get<1> ().set_max_size (3);
-  // // // // x.getPolicy ().get1 ().set_max_size (10);
-  // // // // x.getPolicy ().get2 ().set_max_size (3);
-  
-  // // // // x.getTrie ().PrintStat (std::cout);
-  
-  // ns3::NdnName n1,n2,n3,n4;
-  // // // // n1("a")("b")("c");
-  // // // // n2("a")("b")("d");
-  // // // // n3("a")("b")("f");
-  // // // // n4("a")("b");
-
-  // n1("a");
-  // n2("b");
-  // n3("c");
-  // n4("d");
-
-  // x.insert (n1, ns3::Create<Integer> (1));
-  // x.insert (n2, ns3::Create<Integer> (2));
-  // // // // x.longest_prefix_match (n1);
-  // x.insert (n3, ns3::Create<Integer> (3));
-  // x.insert (n4, ns3::Create<Integer> (4));
-  // x.insert (n4, ns3::Create<Integer> (4));
-
-  // std::cout << "digraph trie {\n";
-  // std::cout << x.getTrie ();
-  // std::cout << "}\n";
-
-  // Ptr<Node> node = CreateObject<Node> ();
-  // Names::Add ("TestNode", node);
-  // Ptr<ndn::App> app = CreateObject<ndn::App> ();
-  // node->AddApplication (app);
-  
-  // ObjectFactory factory ("ns3::ndn::fib::Default");
-  
-  // Ptr<ndn::Fib> fib = factory.Create<ndn::Fib> ();
-  // node->AggregateObject (fib);
-  // Ptr<ndn::Face> face = CreateObject<ndn::AppFace> (app);
-
-  // fib->Add (lexical_cast<ndn::Name> ("/bla"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/1"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/2"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/3"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/1/1"), face, 1);
-  // fib->Add (lexical_cast<ndn::Name> ("/bla/1/2"), face, 1);
-  
-  // cout << *fib << endl;
-
-  // fib->RemoveFromAll (face);
-
-  // cout << *fib << endl;
-  // BOOST_FOREACH (const trie::parent_trie &item, x.getPolicy ())
-  //   {
-  //     std::cout << *item.payload () << " " << std::endl;
-  //   }
-
-  // ns3::NdnName n4;
-  // n4("a")("c");
-    
-  // // std::cout << *x->find (n4).get<0> ();
-
-  // x->prune ();
-  // // x->find (n5).get<0> ()->erase ();
-  // x->find (n1).get<0> ()->erase ();
-    
-  // std::cout << "digraph trie {\n";
-  // std::cout << *x;
-  // std::cout << "}\n";
-
-  // x->PrintStat (std::cout);
-
-  // delete x;
+  return boost::get<2> (trie.getTrie ().find (ndn::Name (name)))->subtree_size ();
 }
 
+template<class Trie>
+bool
+Contains (Trie &trie, const std::string &name)
+{
+  return trie.find_exact (ndn::Name (name)) != trie.end ();
+}
+
+}
+
+void
+TrieTest::CheckChildren ()
+{
+  typedef detail::trie_children<ChildNode> children_type;
+
+  heap_allocator allocator;
+  children_type children;
+  std::vector<ChildNode> nodes (64);
+  for (size_t i = 0; i < nodes.size (); i++)
+    {
+      nodes[i].hash = (i % 20) * 2654435761u; // some children share the hash
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (children.first () == 0, true, "Leaf should have no children");
+
+  children.insert (&nodes[0], nodes[0].hash, allocator);
+  NS_TEST_ASSERT_MSG_EQ (children.capacity (), 0, "Single child should be stored inline");
+  NS_TEST_ASSERT_MSG_EQ (children.find (nodes[0].hash, IsChild (&nodes[0])), &nodes[0], "Inline child should be found");
+
+  for (size_t i = 1; i < children_type::SMALL_CAPACITY; i++)
+    {
+      children.insert (&nodes[i], nodes[i].hash, allocator);
+    }
+  NS_TEST_ASSERT_MSG_EQ (children.is_hashed (), false, "Small number of children should be kept in the sorted array");
+
+  for (size_t i = children_type::SMALL_CAPACITY; i < nodes.size (); i++)
+    {
+      children.insert (&nodes[i], nodes[i].hash, allocator);
+    }
+  NS_TEST_ASSERT_MSG_EQ (children.is_hashed (), true, "Large number of children should be kept in the hash table");
+  NS_TEST_ASSERT_MSG_EQ (children.size (), nodes.size (), "All children should be in the container");
+
+  for (size_t i = 0; i < nodes.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (children.find (nodes[i].hash, IsChild (&nodes[i])), &nodes[i], "Child should be found");
+    }
+
+  // erase every other child while iterating, the rest should still be found after backward shifts
+  size_t visited = 0;
+  for (ChildNode *child = children.first (); child != 0; )
+    {
+      ChildNode *next = children.next (child, child->hash);
+      if ((child - &nodes[0]) % 2 == 0)
+        children.erase (child, child->hash, allocator);
+      child = next;
+      visited ++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (visited, nodes.size (), "Iteration should visit every child once");
+  NS_TEST_ASSERT_MSG_EQ (children.size (), nodes.size () / 2, "Half of children should be erased");
+
+  for (size_t i = 0; i < nodes.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (children.find (nodes[i].hash, IsChild (&nodes[i])) != 0, i % 2 == 1,
+                             "Only children with odd index should be found");
+    }
+
+  // shrink back to the array and then to the inline child
+  for (size_t i = 1; i + 2 < nodes.size (); i += 2)
+    {
+      children.erase (&nodes[i], nodes[i].hash, allocator);
+    }
+  NS_TEST_ASSERT_MSG_EQ (children.size (), 1, "One child should remain");
+  NS_TEST_ASSERT_MSG_EQ (children.capacity (), 0, "Last child should be moved inline");
+  NS_TEST_ASSERT_MSG_EQ (children.first (), &nodes[nodes.size () - 1], "Last child should be the only one");
+
+  children.insert (&nodes[0], nodes[0].hash, allocator);
+  size_t disposed = 0;
+  children.clear_and_dispose (CountingDisposer (disposed), allocator);
+  NS_TEST_ASSERT_MSG_EQ (disposed, 2, "All children should be disposed");
+  NS_TEST_ASSERT_MSG_EQ (children.size (), 0, "Container should be empty after clear");
+}
+
+void
+TrieTest::CheckEraseDuringIteration ()
+{
+  lru_trie trie;
+  trie.getPolicy ().set_max_size (0);
+
+  for (int i = 0; i < 40; i++)
+    {
+      Insert (trie, "/p/" + boost::lexical_cast<std::string> (i), i);
+    }
+
+  for (lru_trie::policy_container::iterator item = trie.getPolicy ().begin ();
+       item != trie.getPolicy ().end (); )
+    {
+      lru_trie::iterator node = &(*item);
+      item ++;
+      if (node->payload ()->GetValue () % 2 == 0)
+        trie.erase (node);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 20, "Half of items should be erased");
+  for (int i = 0; i < 40; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/p/" + boost::lexical_cast<std::string> (i)), i % 2 == 1,
+                             "Only items with odd values should stay");
+    }
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 22, "Nodes of erased items should be pruned");
+}
+
+void
+TrieTest::CheckRadixSplitMerge ()
+{
+  radix_lru_trie trie;
+
+  Insert (trie, "/a/b/c/d", 1);
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 2, "Single prefix should be a single edge");
+
+  // prefix ends in the middle of the edge
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b"), -1, "There should be no match for /a/b");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/a/b/c"), false, "/a/b/c should not be found");
+  radix_lru_trie::iterator subtree = trie.deepest_prefix_match (ndn::Name ("/a/b"));
+  NS_TEST_ASSERT_MSG_EQ (subtree != trie.end (), true, "Subtree of /a/b should be found");
+  NS_TEST_ASSERT_MSG_EQ (subtree->payload ()->GetValue (), 1, "Subtree of /a/b should contain /a/b/c/d");
+
+  Insert (trie, "/a/b/x", 2);
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 4, "Edge should be split at /a/b");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/c/d/e"), 1, "/a/b/c/d should match");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/x/y"), 2, "/a/b/x should match");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/c"), -1, "Split node should not have payload");
+
+  Insert (trie, "/a", 3);
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 5, "Edge should be split at /a");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/c"), 3, "/a should match when key ends mid-edge");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/c/d"), 1, "/a/b/c/d should match exactly");
+
+  // removal of the longest prefix merges /a/b into /a/b/x
+  trie.erase (ndn::Name ("/a/b/c/d"));
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/c/d"), 3, "/a should match after /a/b/c/d is removed");
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 3, "Node without payload and with single child should be merged");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/x"), 2, "/a/b/x should survive the merge");
+
+  trie.erase (ndn::Name ("/a/b/x"));
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 2, "Only /a should remain");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/x"), 3, "/a should match");
+
+  trie.erase (ndn::Name ("/a"));
+  NS_TEST_ASSERT_MSG_EQ (CountNodes (trie), 1, "Only root should remain");
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 0, "Policy should be empty");
+}
+
+void
+TrieTest::CheckSubtreeCounters ()
+{
+  lru_trie trie;
+
+  Insert (trie, "/a/b/c", 1);
+  Insert (trie, "/a/b/d", 2);
+  Insert (trie, "/a/x", 3);
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/"), 3, "Root should count all payloads");
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/a/b"), 2, "/a/b should count payloads of its children");
+
+  lru_trie::iterator item = trie.deepest_prefix_match (ndn::Name ("/a/b"));
+  NS_TEST_ASSERT_MSG_EQ (item != trie.end (), true, "Payload under /a/b should be found");
+  NS_TEST_ASSERT_MSG_EQ (item->payload ()->GetValue () == 1 || item->payload ()->GetValue () == 2, true,
+                         "Payload should be under /a/b");
+
+  item = trie.deepest_prefix_match (ndn::Name ("/a"), HasValue (3));
+  NS_TEST_ASSERT_MSG_EQ (item != trie.end (), true, "Payload satisfying predicate should be found");
+  NS_TEST_ASSERT_MSG_EQ (item->payload ()->GetValue (), 3, "Wrong payload found");
+  NS_TEST_ASSERT_MSG_EQ (trie.deepest_prefix_match (ndn::Name ("/a/b"), HasValue (3)) == trie.end (), true,
+                         "Payload outside of the subtree should not be found");
+
+  // node /a/b stays in the trie, but its subtree has no payloads
+  trie.erase (ndn::Name ("/a/b/c"));
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/a/b"), 1, "Counter should be decremented on erase");
+  NS_TEST_ASSERT_MSG_EQ (trie.deepest_prefix_match (ndn::Name ("/a/b"))->payload ()->GetValue (), 2,
+                         "Remaining payload should be found");
+
+  trie.erase (ndn::Name ("/a/b/d"));
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/a"), 1, "Only /a/x should be counted");
+  NS_TEST_ASSERT_MSG_EQ (trie.deepest_prefix_match (ndn::Name ("/a/b")) == trie.end (), true,
+                         "There should be no payload under /a/b");
+
+  // payload on the inner node
+  Insert (trie, "/a", 4);
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/"), 2, "Payload of the inner node should be counted");
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/a"), 2, "Payload of the node itself should be counted");
+  NS_TEST_ASSERT_MSG_EQ (trie.deepest_prefix_match (ndn::Name ("/a"))->payload ()->GetValue (), 4,
+                         "Payload of the node itself should be found first");
+}
+
+template<class Trie>
+void
+TrieTest::CheckBulkLoad ()
+{
+  Trie trie;
+  Insert (trie, "/a/b", 0);
+
+  const char *names[] = { "/a/b/c", "/x", "/a", "/a/b/c", "/a/b", "/a/b/d/e", "/x/y" };
+  std::vector< std::pair<ndn::Name, Ptr<TestPayload> > > items;
+  for (size_t i = 0; i < sizeof (names) / sizeof (names[0]); i++)
+    {
+      ndn::Name name (names[i]);
+      items.push_back (std::make_pair (name, Create<TestPayload> (name, i + 1)));
+    }
+
+  std::vector< std::pair<typename Trie::iterator, bool> > results;
+  trie.bulk_load (items.begin (), items.end (), &results);
+
+  NS_TEST_ASSERT_MSG_EQ (results.size (), items.size (), "There should be a result for each item");
+  NS_TEST_ASSERT_MSG_EQ (results[0].second, true, "/a/b/c should be inserted");
+  NS_TEST_ASSERT_MSG_EQ (results[3].second, false, "Duplicate should not be inserted");
+  NS_TEST_ASSERT_MSG_EQ (results[3].first, results[0].first, "Duplicate should point to the first item");
+  NS_TEST_ASSERT_MSG_EQ (results[4].second, false, "Existing item should not be replaced");
+  NS_TEST_ASSERT_MSG_EQ (results[4].first->payload ()->GetValue (), 0, "Existing item should keep its payload");
+
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 6, "All distinct prefixes should be in the policy");
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/"), 6, "Subtree counters should be updated");
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/a/b"), 3, "Subtree counters should be updated");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/c/z"), 1, "/a/b/c should match");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/d"), 0, "/a/b should match");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/b/d/e/f"), 6, "/a/b/d/e should match");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/a/q"), 3, "/a should match");
+  NS_TEST_ASSERT_MSG_EQ (LongestPrefixMatch (trie, "/x/y"), 7, "/x/y should match");
+
+  // policy sees new items in the input order
+  Trie bounded;
+  bounded.getPolicy ().set_max_size (2);
+  bounded.bulk_load (items.begin (), items.begin () + 3);
+  NS_TEST_ASSERT_MSG_EQ (bounded.getPolicy ().size (), 2, "Policy limit should be respected");
+  NS_TEST_ASSERT_MSG_EQ (Contains (bounded, "/a/b/c"), false, "The first item should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (Contains (bounded, "/x"), true, "/x should stay");
+  NS_TEST_ASSERT_MSG_EQ (Contains (bounded, "/a"), true, "/a should stay");
+}
+
+void
+TrieTest::CheckLfuBucket ()
+{
+  lfu_bucket_trie trie;
+  trie.getPolicy ().set_max_size (3);
+
+  Insert (trie, "/a", 1);
+  Insert (trie, "/b", 2);
+  Insert (trie, "/c", 3);
+  LongestPrefixMatch (trie, "/a");
+  LongestPrefixMatch (trie, "/a");
+  LongestPrefixMatch (trie, "/c");
+
+  NS_TEST_ASSERT_MSG_EQ (lfu_bucket_trie::policy_container::policy_base::get_order (trie.find_exact (ndn::Name ("/a"))), 2,
+                         "/a should have been used twice");
+
+  Insert (trie, "/d", 4);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/b"), false, "The least frequently used item should be evicted");
+
+  Insert (trie, "/e", 5);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/d"), false, "New item is the least frequently used one");
+
+  // /c and /e are used once, but /c was used earlier
+  LongestPrefixMatch (trie, "/e");
+  Insert (trie, "/f", 6);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/c"), false, "Tie should be broken in LRU order");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/a"), true, "/a should stay");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/e"), true, "/e should stay");
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().begin ()->payload ()->GetValue (), 6, "/f should be the next victim");
+}
+
+void
+TrieTest::CheckArcGhostHit ()
+{
+  arc_trie trie;
+  trie.getPolicy ().set_max_size (2);
+
+  Insert (trie, "/a", 1);
+  LongestPrefixMatch (trie, "/a");
+  Insert (trie, "/b", 2);
+  NS_TEST_ASSERT_MSG_EQ (arc_trie::policy_container::policy_base::get_order (trie.find_exact (ndn::Name ("/a"))), true,
+                         "Hit item should be in T2");
+  NS_TEST_ASSERT_MSG_EQ (arc_trie::policy_container::policy_base::get_order (trie.find_exact (ndn::Name ("/b"))), false,
+                         "New item should be in T1");
+
+  Insert (trie, "/c", 3);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/b"), false, "The least recently used item of T1 should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 2, "Cache should be full");
+
+  // ghost hit in B1: /b goes straight to T2, T1 target grows, so /a is evicted from T2
+  Insert (trie, "/b", 2);
+  NS_TEST_ASSERT_MSG_EQ (arc_trie::policy_container::policy_base::get_order (trie.find_exact (ndn::Name ("/b"))), true,
+                         "Item remembered in B1 should be inserted into T2");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/a"), false, "/a should be evicted from T2");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/c"), true, "/c should stay in T1");
+
+  // ghost hit in B2: T1 target shrinks, so /c is evicted from T1
+  Insert (trie, "/a", 1);
+  NS_TEST_ASSERT_MSG_EQ (arc_trie::policy_container::policy_base::get_order (trie.find_exact (ndn::Name ("/a"))), true,
+                         "Item remembered in B2 should be inserted into T2");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/c"), false, "/c should be evicted from T1");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/b"), true, "/b should stay in T2");
+}
+
+void
+TrieTest::CheckTinyLfu ()
+{
+  frequency_sketch sketch;
+  sketch.resize (16); // counters are halved after 160 increments
+
+  for (int i = 0; i < 20; i++)
+    {
+      sketch.increment (1);
+    }
+  NS_TEST_ASSERT_MSG_EQ (static_cast<int> (sketch.estimate (1)), 15, "Counters should saturate");
+  NS_TEST_ASSERT_MSG_EQ (static_cast<int> (sketch.estimate (2)) < 15, true, "Other keys should not be affected");
+
+  for (int i = 0; i < 200; i++)
+    {
+      sketch.increment (1000 + i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (static_cast<int> (sketch.estimate (1)), 7, "Counters should be halved once");
+
+  tinylfu_trie trie;
+  trie.getPolicy ().set_max_size (2);
+
+  Insert (trie, "/a", 1);
+  Insert (trie, "/b", 2);
+  LongestPrefixMatch (trie, "/a");
+  LongestPrefixMatch (trie, "/a");
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 2, "Items should be admitted while cache is not full");
+
+  // /b is the LRU victim, /c is as frequent as /b
+  Insert (trie, "/c", 3);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/c"), false, "Candidate should be rejected on tie");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/b"), true, "Victim should stay if candidate is rejected");
+
+  // rejected insert attempt is still counted
+  Insert (trie, "/c", 3);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/c"), true, "More frequent candidate should be admitted");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/b"), false, "Victim should be evicted");
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 2, "Cache should stay full");
+
+  // /a is the LRU victim now, but it is used more often than the new item
+  Insert (trie, "/d", 4);
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/d"), false, "Less frequent candidate should be rejected");
+  NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/a"), true, "Frequently used item should stay");
+}
+
+void
+TrieTest::CheckRandom ()
+{
+  random_trie trie;
+  trie.getPolicy ().set_max_size (10);
+
+  for (int i = 0; i < 100; i++)
+    {
+      Insert (trie, "/r/" + boost::lexical_cast<std::string> (i), i);
+      NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), std::min (i + 1, 10), "Policy limit should be respected");
+    }
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/"), 10, "Evicted items should be removed from the trie");
+
+  // erase items in the middle and at the end of the array, positions of moved items should be updated
+  trie.erase (&(*trie.getPolicy ().begin ()));
+  trie.erase (&(*(trie.getPolicy ().begin () + 4)));
+  trie.erase (&(*(trie.getPolicy ().end () - 1)));
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 7, "Three items should be erased");
+
+  size_t position = 0;
+  for (random_trie::policy_container::iterator item = trie.getPolicy ().begin ();
+       item != trie.getPolicy ().end (); item++, position++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (random_trie::policy_container::policy_base::get_order (&(*item)), position,
+                             "Item should know its position in the array");
+      NS_TEST_ASSERT_MSG_EQ (Contains (trie, "/r/" + boost::lexical_cast<std::string> (item->payload ()->GetValue ())), true,
+                             "Item in the policy should be in the trie");
+    }
+  NS_TEST_ASSERT_MSG_EQ (SubtreeSize (trie, "/"), 7, "Only items in the policy should be in the trie");
+
+  trie.getPolicy ().set_max_size (0);
+  for (int i = 100; i < 200; i++)
+    {
+      Insert (trie, "/r/" + boost::lexical_cast<std::string> (i), i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (trie.getPolicy ().size (), 107, "Nothing should be evicted without limit");
+}
+
+void
+TrieTest::DoRun ()
+{
+  CheckChildren ();
+  CheckEraseDuringIteration ();
+  CheckRadixSplitMerge ();
+  CheckSubtreeCounters ();
+  CheckBulkLoad<lru_trie> ();
+  CheckBulkLoad<radix_lru_trie> ();
+  CheckLfuBucket ();
+  CheckArcGhostHit ();
+  CheckTinyLfu ();
+  CheckRandom ();
+}
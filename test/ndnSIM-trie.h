@@ -37,6 +37,19 @@ public:
     
 private:
   virtual void DoRun ();
+
+  void CheckChildren ();
+  void CheckEraseDuringIteration ();
+  void CheckRadixSplitMerge ();
+  void CheckSubtreeCounters ();
+
+  template<class Trie>
+  void CheckBulkLoad ();
+
+  void CheckLfuBucket ();
+  void CheckArcGhostHit ();
+  void CheckTinyLfu ();
+  void CheckRandom ();
 };
 
 }
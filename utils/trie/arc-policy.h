@@ -0,0 +1,326 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef ARC_POLICY_H_
+#define ARC_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for Adaptive Replacement Cache (ARC) policy
+ *
+ * Items that were seen only once recently (T1) and items that were hit at least once (T2) are kept
+ * in a single list: T1 from the least to the most recently used item, followed by T2 in the same order.
+ * Items evicted from T1 and T2 are remembered in ghost lists (B1 and B2), which hold only hashes
+ * of the names and are bounded by the cache size.  Hits in the ghost lists adapt the target
+ * size of T1, so the cache balances between recency and frequency, and one-time scans cannot
+ * flush frequently used items.  All operations are O(1).
+ *
+ * Payload must provide GetName () (e.g., content store entries).  As ghost lists store only hashes,
+ * a hash collision can be (rarely) taken as a ghost hit, which affects only the adaptation.
+ */
+struct arc_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "Arc"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { bool frequent; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  /**
+   * @brief List of hashes of the evicted names (from the oldest to the most recent), with O(1) lookup
+   */
+  typedef boost::multi_index::multi_index_container<
+    std::size_t,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<>,
+      boost::multi_index::hashed_unique< boost::multi_index::identity<std::size_t> >
+      >
+    > ghost_container;
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    static policy_hook_type &
+    get_hook (typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    /**
+     * @brief Check if item is in the frequency (T2) part of the cache
+     */
+    static bool
+    get_order (typename Container::const_iterator item)
+    {
+      return static_cast<const policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item))->frequent;
+    }
+
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_order methods from outside
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+        , target_ (0)
+        , recentSize_ (0)
+        , frequentFirst_ (0)
+      {
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        unlink (item);
+        push_frequent (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        if (max_size_ == 0)
+          {
+            push_recent (item); // no eviction, no need to track anything
+            return true;
+          }
+
+        std::size_t key = get_key (item);
+        ghost_container::nth_index<1>::type::iterator ghost;
+
+        if ((ghost = recentGhosts_.get<1> ().find (key)) != recentGhosts_.get<1> ().end ())
+          {
+            // was recently evicted from T1, T1 should be larger
+            size_t delta = std::max<size_t> (1, frequentGhosts_.size () / recentGhosts_.size ());
+            target_ = std::min (max_size_, target_ + delta);
+            recentGhosts_.get<1> ().erase (ghost);
+
+            if (policy_container::size () >= max_size_)
+              replace (false);
+            push_frequent (item);
+          }
+        else if ((ghost = frequentGhosts_.get<1> ().find (key)) != frequentGhosts_.get<1> ().end ())
+          {
+            // was recently evicted from T2, T2 should be larger
+            size_t delta = std::max<size_t> (1, recentGhosts_.size () / frequentGhosts_.size ());
+            target_ = (target_ > delta) ? target_ - delta : 0;
+            frequentGhosts_.get<1> ().erase (ghost);
+
+            if (policy_container::size () >= max_size_)
+              replace (true);
+            push_frequent (item);
+          }
+        else
+          {
+            if (recentSize_ + recentGhosts_.size () >= max_size_)
+              {
+                if (recentSize_ < max_size_)
+                  {
+                    recentGhosts_.pop_front ();
+                    if (policy_container::size () >= max_size_)
+                      replace (false);
+                  }
+                else
+                  {
+                    // T1 occupies the whole cache, the oldest item is dropped without remembering it
+                    base_.erase (&(*policy_container::begin ()));
+                  }
+              }
+            else if (policy_container::size () + recentGhosts_.size () + frequentGhosts_.size () >= max_size_)
+              {
+                if (policy_container::size () + recentGhosts_.size () + frequentGhosts_.size () >= 2 * max_size_ &&
+                    !frequentGhosts_.empty ())
+                  frequentGhosts_.pop_front ();
+
+                if (policy_container::size () >= max_size_)
+                  replace (false);
+              }
+            push_recent (item);
+          }
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        unlink (item);
+        push_frequent (item);
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        unlink (item);
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        recentSize_ = 0;
+        frequentFirst_ = 0;
+        target_ = 0;
+        recentGhosts_.clear ();
+        frequentGhosts_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        target_ = std::min (target_, max_size_);
+        trim_ghosts ();
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      static inline std::size_t
+      get_key (typename parent_trie::iterator item)
+      {
+        return item->payload ()->GetName ().GetPrefixHash (item->payload ()->GetName ().size ());
+      }
+
+      /**
+       * @brief Evict the least recently used item either from T1 or from T2, depending on the target size of T1
+       */
+      void
+      replace (bool frequentGhostHit)
+      {
+        if (recentSize_ > 0 &&
+            (recentSize_ > target_ || (frequentGhostHit && recentSize_ == target_) || frequentFirst_ == 0))
+          evict (&(*policy_container::begin ()), recentGhosts_);
+        else
+          evict (frequentFirst_, frequentGhosts_);
+      }
+
+      inline void
+      evict (typename parent_trie::iterator item, ghost_container &ghosts)
+      {
+        std::pair<ghost_container::iterator, bool> ghost = ghosts.push_back (get_key (item));
+        if (!ghost.second)
+          ghosts.relocate (ghosts.end (), ghost.first);
+        trim_ghosts ();
+
+        base_.erase (item);
+      }
+
+      /**
+       * @brief Make sure ghost lists do not remember more names than the cache can hold
+       */
+      inline void
+      trim_ghosts ()
+      {
+        while (recentGhosts_.size () + frequentGhosts_.size () > max_size_)
+          {
+            if (recentGhosts_.size () > frequentGhosts_.size ())
+              recentGhosts_.pop_front ();
+            else
+              frequentGhosts_.pop_front ();
+          }
+      }
+
+      inline void
+      push_recent (typename parent_trie::iterator item)
+      {
+        get_hook (item).frequent = false;
+        if (frequentFirst_ == 0)
+          policy_container::push_back (*item);
+        else
+          policy_container::insert (policy_container::s_iterator_to (*frequentFirst_), *item);
+        recentSize_ ++;
+      }
+
+      inline void
+      push_frequent (typename parent_trie::iterator item)
+      {
+        get_hook (item).frequent = true;
+        policy_container::push_back (*item);
+        if (frequentFirst_ == 0)
+          frequentFirst_ = &(*item);
+      }
+
+      inline void
+      unlink (typename parent_trie::iterator item)
+      {
+        typename policy_container::iterator self = policy_container::s_iterator_to (*item);
+        if (!get_hook (item).frequent)
+          recentSize_ --;
+        else if (frequentFirst_ == &(*item))
+          {
+            typename policy_container::iterator following = self;
+            following ++;
+            frequentFirst_ = (following != policy_container::end ()) ? &(*following) : 0;
+          }
+        policy_container::erase (self);
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+
+      size_t target_;              ///< @brief target size of T1
+      size_t recentSize_;          ///< @brief number of items in T1
+      Container *frequentFirst_;   ///< @brief the least recently used item in T2 (0 if T2 is empty)
+
+      ghost_container recentGhosts_;   ///< @brief B1, names evicted from T1
+      ghost_container frequentGhosts_; ///< @brief B2, names evicted from T2
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // ARC_POLICY_H_
@@ -21,7 +21,10 @@
 #ifndef FUNCTOR_HOOK_H_
 #define FUNCTOR_HOOK_H_
 
+#include "multi-type-container.h"
+
 #include <boost/intrusive/parent_from_member.hpp>
+#include <boost/intrusive/options.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -62,6 +65,39 @@ struct FunctorHook
   }
 };
 
+/**
+ * @brief Access to the policy hook of the item, for policies that are not based on boost::intrusive containers
+ *
+ * Hook is either boost::intrusive::member_hook (standalone policy) or boost::intrusive::function_hook
+ * with FunctorHook (policy inside multi_policy_traits)
+ */
+template<class Hook>
+struct policy_hook;
+
+template<class Parent, class MemberHook, MemberHook Parent::* PtrToMember>
+struct policy_hook< boost::intrusive::member_hook<Parent, MemberHook, PtrToMember> >
+{
+  static MemberHook &
+  get (Parent &value)
+  { return value.*PtrToMember; }
+
+  static const MemberHook &
+  get (const Parent &value)
+  { return value.*PtrToMember; }
+};
+
+template<class Functor>
+struct policy_hook< boost::intrusive::function_hook<Functor> >
+{
+  static typename Functor::hook_type &
+  get (typename Functor::value_type &value)
+  { return *Functor::to_hook_ptr (value); }
+
+  static const typename Functor::hook_type &
+  get (const typename Functor::value_type &value)
+  { return *Functor::to_hook_ptr (value); }
+};
+
 } // detail
 } // ndnSIM
 } // ndn
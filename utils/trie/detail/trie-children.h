@@ -0,0 +1,466 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TRIE_CHILDREN_H_
+#define TRIE_CHILDREN_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+namespace detail {
+
+/**
+ * @brief Set of trie node children, which adapts its layout to the node fan-out
+ *
+ * - no children (leaf): nothing is allocated
+ * - one child: stored inline
+ * - up to SMALL_CAPACITY children: small heap array, sorted by prefix hash
+ * - more children: open-addressing hash table with linear probing
+ *
+ * Children are identified by (precomputed) hash of the full prefix and node pointer.
+ * The container does not own the nodes, it is up to the trie to dispose them.
+ * Child arrays are requested from the allocator passed to the modifying methods,
+ * and the owner must call clear_and_dispose before the container is destroyed.
+ */
+template<class Node>
+class trie_children
+{
+public:
+  static const uint32_t SMALL_CAPACITY = 8;
+
+  trie_children ()
+    : size_ (0)
+    , capacity_ (0)
+  {
+    inline_.hash = 0;
+    inline_.node = 0;
+  }
+
+  inline size_t
+  size () const
+  {
+    return size_;
+  }
+
+  /**
+   * @brief Number of allocated slots (0 if children are stored inline)
+   */
+  inline size_t
+  capacity () const
+  {
+    return capacity_;
+  }
+
+  /**
+   * @brief Check if the container switched to the hash table layout
+   */
+  inline bool
+  is_hashed () const
+  {
+    return capacity_ > SMALL_CAPACITY;
+  }
+
+  /**
+   * @brief Get first child in the iteration order (0 if there are no children)
+   */
+  inline Node *
+  first () const
+  {
+    if (size_ == 0)
+      return 0;
+
+    if (capacity_ == 0)
+      return inline_.node;
+
+    if (!is_hashed ())
+      return slots_[0].node;
+
+    return scan (0);
+  }
+
+  /**
+   * @brief Get child that follows the specified child in the iteration order (0 if it was the last one)
+   * @param child child node, which must be in the container
+   * @param hash  hash of the child node
+   */
+  inline Node *
+  next (const Node *child, std::size_t hash) const
+  {
+    if (capacity_ == 0)
+      return 0;
+
+    size_t pos = position (child, hash);
+    if (!is_hashed ())
+      return (pos + 1 < size_) ? slots_[pos + 1].node : 0;
+
+    return scan (pos + 1);
+  }
+
+  /**
+   * @brief Find child with the specified hash that satisfies the predicate
+   * @param hash hash of the full prefix of the child
+   * @param pred predicate, called as pred (const Node &) only for children with matching hash
+   * @returns pointer to the child or 0 if not found
+   */
+  template<class Predicate>
+  inline Node *
+  find (std::size_t hash, Predicate pred) const
+  {
+    if (capacity_ == 0)
+      {
+        if (size_ != 0 && inline_.hash == hash && pred (*inline_.node))
+          return inline_.node;
+        return 0;
+      }
+
+    if (!is_hashed ())
+      {
+        for (size_t i = 0; i < size_ && slots_[i].hash <= hash; i++)
+          {
+            if (slots_[i].hash == hash && pred (*slots_[i].node))
+              return slots_[i].node;
+          }
+        return 0;
+      }
+
+    size_t mask = capacity_ - 1;
+    for (size_t i = home (hash); slots_[i].node != 0; i = (i + 1) & mask)
+      {
+        if (slots_[i].hash == hash && pred (*slots_[i].node))
+          return slots_[i].node;
+      }
+    return 0;
+  }
+
+  /**
+   * @brief Add child to the container (the child must not be already in the container)
+   */
+  template<class Allocator>
+  inline void
+  insert (Node *child, std::size_t hash, Allocator &allocator)
+  {
+    if (size_ == 0 && capacity_ == 0)
+      {
+        inline_.hash = hash;
+        inline_.node = child;
+        size_ = 1;
+        return;
+      }
+
+    if (capacity_ == 0)
+      {
+        entry single = inline_;
+        slots_ = static_cast<entry*> (allocator.allocate (2 * sizeof (entry)));
+        capacity_ = 2;
+        slots_[0] = single;
+      }
+    else if (size_ == capacity_ && capacity_ < SMALL_CAPACITY)
+      {
+        resize_array (capacity_ * 2, allocator);
+      }
+    else if (size_ == capacity_)
+      {
+        resize_table (SMALL_CAPACITY * 2, allocator);
+      }
+    else if (is_hashed () && (size_ + 1) * 4 > capacity_ * 3)
+      {
+        resize_table (capacity_ * 2, allocator);
+      }
+
+    if (!is_hashed ())
+      {
+        size_t pos = size_;
+        for (; pos > 0 && slots_[pos - 1].hash > hash; pos--)
+          {
+            slots_[pos] = slots_[pos - 1];
+          }
+        slots_[pos].hash = hash;
+        slots_[pos].node = child;
+      }
+    else
+      {
+        place (slots_, capacity_, hash, child);
+      }
+    size_ ++;
+  }
+
+  /**
+   * @brief Preallocate space for n children, so they can be inserted without intermediate resizes
+   *        (e.g., when the trie is built from a known set of keys)
+   */
+  template<class Allocator>
+  inline void
+  reserve (size_t n, Allocator &allocator)
+  {
+    if (n <= 1)
+      return;
+
+    size_t capacity = 2;
+    while (capacity < n && capacity < SMALL_CAPACITY)
+      capacity *= 2;
+    if (n > SMALL_CAPACITY)
+      {
+        capacity = SMALL_CAPACITY * 2;
+        while (n * 4 > capacity * 3)
+          capacity *= 2;
+      }
+
+    if (capacity <= capacity_)
+      return;
+
+    if (capacity_ == 0)
+      {
+        // inline child (if any) is moved into a one-element array, which is then resized as usual
+        entry single = inline_;
+        slots_ = static_cast<entry*> (allocator.allocate (sizeof (entry)));
+        capacity_ = 1;
+        slots_[0] = single;
+      }
+
+    if (capacity <= SMALL_CAPACITY)
+      resize_array (capacity, allocator);
+    else
+      resize_table (capacity, allocator);
+  }
+
+  /**
+   * @brief Remove child from the container (the child must be in the container)
+   */
+  template<class Allocator>
+  inline void
+  erase (const Node *child, std::size_t hash, Allocator &allocator)
+  {
+    if (capacity_ == 0)
+      {
+        inline_.hash = 0;
+        inline_.node = 0;
+        size_ = 0;
+        return;
+      }
+
+    size_t pos = position (child, hash);
+    if (!is_hashed ())
+      {
+        for (size_t i = pos + 1; i < size_; i++)
+          {
+            slots_[i - 1] = slots_[i];
+          }
+        size_ --;
+
+        if (size_ == 1)
+          {
+            entry single = slots_[0];
+            allocator.deallocate (slots_, capacity_ * sizeof (entry));
+            capacity_ = 0;
+            inline_ = single;
+          }
+        return;
+      }
+
+    // backward shift deletion, so the table never accumulates tombstones
+    size_t mask = capacity_ - 1;
+    size_t hole = pos;
+    for (size_t i = (hole + 1) & mask; slots_[i].node != 0; i = (i + 1) & mask)
+      {
+        size_t desired = home (slots_[i].hash);
+        bool canMove = (hole <= i) ? (desired <= hole || desired > i) : (desired <= hole && desired > i);
+        if (canMove)
+          {
+            slots_[hole] = slots_[i];
+            hole = i;
+          }
+      }
+    slots_[hole].node = 0;
+    size_ --;
+
+    if (size_ <= SMALL_CAPACITY / 2)
+      {
+        resize_array (SMALL_CAPACITY, allocator);
+      }
+  }
+
+  /**
+   * @brief Remove all children, calling disposer for each of them
+   */
+  template<class Disposer, class Allocator>
+  inline void
+  clear_and_dispose (Disposer disposer, Allocator &allocator)
+  {
+    if (capacity_ == 0)
+      {
+        if (size_ != 0)
+          {
+            Node *child = inline_.node;
+            inline_.node = 0;
+            size_ = 0;
+            disposer (child);
+          }
+        return;
+      }
+
+    entry *slots = slots_;
+    size_t capacity = capacity_;
+    size_t count = is_hashed () ? capacity_ : size_;
+    size_ = 0;
+    capacity_ = 0;
+    inline_.hash = 0;
+    inline_.node = 0;
+
+    for (size_t i = 0; i < count; i++)
+      {
+        if (slots[i].node != 0)
+          disposer (slots[i].node);
+      }
+    allocator.deallocate (slots, capacity * sizeof (entry));
+  }
+
+private:
+  // non-copyable
+  trie_children (const trie_children &);
+  trie_children &
+  operator= (const trie_children &);
+
+  struct entry
+  {
+    std::size_t hash;
+    Node *node;
+  };
+
+  inline size_t
+  home (std::size_t hash) const
+  {
+    return (hash ^ (hash >> 16)) & (capacity_ - 1);
+  }
+
+  inline size_t
+  position (const Node *child, std::size_t hash) const
+  {
+    if (!is_hashed ())
+      {
+        size_t i = 0;
+        while (slots_[i].node != child)
+          i++;
+        return i;
+      }
+
+    size_t mask = capacity_ - 1;
+    size_t i = home (hash);
+    while (slots_[i].node != child)
+      i = (i + 1) & mask;
+    return i;
+  }
+
+  inline Node *
+  scan (size_t from) const
+  {
+    for (size_t i = from; i < capacity_; i++)
+      {
+        if (slots_[i].node != 0)
+          return slots_[i].node;
+      }
+    return 0;
+  }
+
+  inline void
+  place (entry *slots, size_t capacity, std::size_t hash, Node *child) const
+  {
+    size_t mask = capacity - 1;
+    size_t i = (hash ^ (hash >> 16)) & mask;
+    while (slots[i].node != 0)
+      i = (i + 1) & mask;
+    slots[i].hash = hash;
+    slots[i].node = child;
+  }
+
+  /**
+   * @brief Move children into a sorted array of the specified capacity (size_ must fit)
+   */
+  template<class Allocator>
+  void
+  resize_array (size_t capacity, Allocator &allocator)
+  {
+    entry *slots = static_cast<entry*> (allocator.allocate (capacity * sizeof (entry)));
+    if (!is_hashed ())
+      {
+        for (size_t i = 0; i < size_; i++)
+          slots[i] = slots_[i];
+      }
+    else
+      {
+        size_t count = 0;
+        for (size_t i = 0; i < capacity_; i++)
+          {
+            if (slots_[i].node == 0)
+              continue;
+
+            size_t pos = count++;
+            for (; pos > 0 && slots[pos - 1].hash > slots_[i].hash; pos--)
+              slots[pos] = slots[pos - 1];
+            slots[pos] = slots_[i];
+          }
+      }
+
+    allocator.deallocate (slots_, capacity_ * sizeof (entry));
+    slots_ = slots;
+    capacity_ = capacity;
+  }
+
+  /**
+   * @brief Move children into a hash table of the specified (power of two) capacity
+   */
+  template<class Allocator>
+  void
+  resize_table (size_t capacity, Allocator &allocator)
+  {
+    entry *slots = static_cast<entry*> (allocator.allocate (capacity * sizeof (entry)));
+    for (size_t i = 0; i < capacity; i++)
+      slots[i].node = 0;
+
+    size_t count = is_hashed () ? capacity_ : size_;
+    for (size_t i = 0; i < count; i++)
+      {
+        if (slots_[i].node != 0)
+          place (slots, capacity, slots_[i].hash, slots_[i].node);
+      }
+
+    allocator.deallocate (slots_, capacity_ * sizeof (entry));
+    slots_ = slots;
+    capacity_ = capacity;
+  }
+
+private:
+  uint32_t size_;
+  uint32_t capacity_; ///< 0 when child is inline, <= SMALL_CAPACITY for sorted array, hash table size otherwise
+  union
+  {
+    entry inline_;
+    entry *slots_;
+  };
+};
+
+} // detail
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TRIE_CHILDREN_H_
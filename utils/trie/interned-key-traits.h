@@ -0,0 +1,60 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef INTERNED_KEY_TRAITS_H_
+#define INTERNED_KEY_TRAITS_H_
+
+#include "trie.h"
+#include "../../model/ndn-name-dictionary.h"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Trie nodes keep references to interned components (see name::Dictionary) instead of copies of the components
+ *
+ * Components are interned only when nodes are created (insert), lookups compare bytes of the key with
+ * the dictionary record and never add new components.  Reference to the component is released when
+ * the node is destroyed.  Suitable for tables with long-living entries and many repeated components (e.g., FIB).
+ */
+template<typename FullKey>
+struct interned_key_traits
+{
+  typedef name::InternedComponent key_type; // what is stored in the trie node
+
+  template<class NameLike>
+  static key_type
+  make_key (const NameLike &key, size_t index) { return key_type (key.get (index)); }
+
+  template<class NameLike>
+  static bool
+  equal (const NameLike &key, size_t index, const key_type &nodeKey) { return key.get (index) == nodeKey.GetComponent (); }
+
+  template<class NameLike>
+  static bool
+  equal_at (const NameLike &key, size_t index, const FullKey &prefix) { return key.get (index) == prefix.get (index); }
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // INTERNED_KEY_TRAITS_H_
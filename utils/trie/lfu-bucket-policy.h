@@ -0,0 +1,285 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef LFU_BUCKET_POLICY_H_
+#define LFU_BUCKET_POLICY_H_
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for LFU replacement policy with O(1) lookup, insert, and eviction
+ *
+ * All items are kept in a single list, ordered by access frequency (least frequently used first)
+ * and, for items with the same frequency, by the time of the last access (least recently used first).
+ * Items with the same frequency form a contiguous group, which is described by a frequency bucket.
+ * Buckets are linked in the increasing frequency order, so an accessed item can always be moved
+ * to the next group (or the new group can be created right after the current one) in constant time.
+ *
+ * Unlike lfu_policy_traits, tie between equally frequent items is broken in LRU order.
+ */
+struct lfu_bucket_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "LfuBucket"; }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> { void *bucket; };
+
+  template<class Container>
+  struct container_hook
+  {
+    typedef boost::intrusive::member_hook< Container,
+                                           policy_hook_type,
+                                           &Container::policy_hook_ > type;
+  };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    typedef typename boost::intrusive::list< Container, Hook > policy_container;
+
+    /**
+     * @brief Group of items with the same access frequency
+     */
+    struct bucket : public boost::intrusive::list_base_hook<>
+    {
+      uint64_t frequency;
+      size_t count;
+      Container *last; ///< @brief the most recently used item in the group
+    };
+
+    typedef typename boost::intrusive::list< bucket > bucket_container;
+
+    static policy_hook_type &
+    get_hook (typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>
+        (policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    static bucket *
+    get_bucket (typename Container::iterator item)
+    {
+      return static_cast<bucket*> (get_hook (item).bucket);
+    }
+
+    static uint64_t
+    get_order (typename Container::const_iterator item)
+    {
+      return static_cast<const bucket*>
+        (static_cast<const policy_hook_type*>
+         (policy_container::value_traits::to_node_ptr(*item))->bucket)->frequency;
+    }
+
+    class type : public policy_container
+    {
+    public:
+      typedef policy policy_base; // to get access to get_order methods from outside
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+      {
+      }
+
+      ~type ()
+      {
+        clear ();
+        spare_.clear_and_dispose (bucket_disposer ());
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        promote (item);
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        if (max_size_ != 0 && policy_container::size () >= max_size_)
+          {
+            // this erases the "least frequently used item" from cache
+            base_.erase (&(*policy_container::begin ()));
+          }
+
+        if (!buckets_.empty () && buckets_.front ().frequency == 0)
+          {
+            bucket &zero = buckets_.front ();
+            policy_container::insert (++policy_container::s_iterator_to (*zero.last), *item);
+            join (zero, item);
+          }
+        else
+          {
+            policy_container::push_front (*item);
+            join (create_bucket (buckets_.begin (), 0), item);
+          }
+        return true;
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        promote (item);
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+        leave (*get_bucket (item), item);
+        policy_container::erase (policy_container::s_iterator_to (*item));
+      }
+
+      inline void
+      clear ()
+      {
+        policy_container::clear ();
+        while (!buckets_.empty ())
+          {
+            bucket &b = buckets_.front ();
+            buckets_.pop_front ();
+            spare_.push_back (b);
+          }
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      /**
+       * @brief Move item to the end of the next frequency group
+       */
+      void
+      promote (typename parent_trie::iterator item)
+      {
+        bucket &current = *get_bucket (item);
+        typename bucket_container::iterator next = ++buckets_.iterator_to (current);
+        bool nextExists = (next != buckets_.end () && next->frequency == current.frequency + 1);
+
+        if (current.count == 1 && !nextExists)
+          {
+            // the only item in the group, frequency can be bumped in place
+            current.frequency ++;
+            return;
+          }
+
+        typename policy_container::iterator position =
+          ++policy_container::s_iterator_to (nextExists ? *next->last : *current.last);
+
+        bucket &target = nextExists ? *next : create_bucket (next, current.frequency + 1);
+        leave (current, item);
+        policy_container::splice (position, *this, policy_container::s_iterator_to (*item));
+        join (target, item);
+      }
+
+      /**
+       * @brief Register item, which was just placed right after the last item of the bucket
+       */
+      inline void
+      join (bucket &b, typename parent_trie::iterator item)
+      {
+        b.last = &(*item);
+        b.count ++;
+        get_hook (item).bucket = &b;
+      }
+
+      /**
+       * @brief Unregister item from the bucket (item should still be in the list)
+       */
+      inline void
+      leave (bucket &b, typename parent_trie::iterator item)
+      {
+        b.count --;
+        if (b.count == 0)
+          {
+            buckets_.erase (buckets_.iterator_to (b));
+            spare_.push_back (b);
+            return;
+          }
+
+        if (b.last == &(*item))
+          {
+            typename policy_container::iterator preceding = policy_container::s_iterator_to (*item);
+            b.last = &(*(--preceding));
+          }
+      }
+
+      /**
+       * @brief Create an empty bucket before the specified position, reusing previously freed buckets
+       */
+      inline bucket &
+      create_bucket (typename bucket_container::iterator position, uint64_t frequency)
+      {
+        bucket *b;
+        if (!spare_.empty ())
+          {
+            b = &spare_.back ();
+            spare_.pop_back ();
+          }
+        else
+          b = new bucket ();
+
+        b->frequency = frequency;
+        b->count = 0;
+        b->last = 0;
+        buckets_.insert (position, *b);
+        return *b;
+      }
+
+      struct bucket_disposer
+      {
+        void operator() (bucket *b) { delete b; }
+      };
+
+    private:
+      Base &base_;
+      size_t max_size_;
+
+      bucket_container buckets_; ///< @brief frequency buckets, in the increasing frequency order
+      bucket_container spare_;   ///< @brief freed buckets, which can be reused
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // LFU_BUCKET_POLICY_H_
@@ -0,0 +1,768 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef RADIX_TRIE_H_
+#define RADIX_TRIE_H_
+
+#include "trie.h"
+
+#include <algorithm>
+#include <iterator>
+#include <boost/type_traits/remove_pointer.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Path-compressed (radix) variant of trie
+ *
+ * Chains of nodes that have neither payload nor siblings are collapsed into a single node,
+ * which is labeled with several name components.  Each node keeps a copy of the full prefix
+ * it represents (FullKey shares component storage with the inserted key, see Name::cut),
+ * so the edge label is the part of the prefix after the parent's prefix.
+ *
+ * Nodes with payload are never moved or merged, so iterators to them (e.g., those kept by
+ * policies and PIT/CS entries) stay valid until the payload is erased.
+ *
+ * The interface is the same as in trie, so radix_trie can be used as the Engine of trie_with_policy.
+ * FullKey must provide cut (), and keys other than FullKey must provide ToName ().
+ */
+template<typename FullKey,
+         typename PayloadTraits,
+         typename PolicyHook,
+         typename KeyTraits = component_key_traits<FullKey>,
+         typename Allocator = heap_allocator>
+class radix_trie : private detail::allocator_holder<Allocator>
+{
+public:
+  typedef FullKey Key; ///< each node is identified by its full prefix
+
+  typedef radix_trie*       iterator;
+  typedef const radix_trie* const_iterator;
+
+  typedef trie_iterator<radix_trie, radix_trie> recursive_iterator;
+  typedef trie_iterator<const radix_trie, radix_trie> const_recursive_iterator;
+
+  typedef trie_point_iterator<radix_trie> point_iterator;
+  typedef trie_point_iterator<const radix_trie> const_point_iterator;
+
+  typedef PayloadTraits payload_traits;
+  typedef Allocator allocator_type;
+
+  /**
+   * @brief Create root of the trie
+   * @param key       key of the root node (normally, an empty name)
+   * @param allocator allocator for all nodes of the trie (must outlive the trie)
+   */
+  inline
+  radix_trie (const Key &key, Allocator &allocator)
+    : detail::allocator_holder<Allocator> (allocator)
+    , prefix_ (key)
+    , hash_ (0)
+    , payload_ (PayloadTraits::empty_payload)
+    , parent_ (0)
+    , subtree_payloads_ (0)
+  {
+  }
+
+  inline
+  ~radix_trie ()
+  {
+    payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
+    children_.clear_and_dispose (trie_delete_disposer (), this->get_allocator ());
+  }
+
+  void
+  clear ()
+  {
+    update_subtree_payloads (-static_cast<ptrdiff_t> (subtree_payloads_ - has_payload ()));
+    children_.clear_and_dispose (trie_delete_disposer (), this->get_allocator ());
+  }
+
+  template<class Predicate>
+  void
+  clear_if (Predicate cond)
+  {
+    recursive_iterator trieNode (this);
+    recursive_iterator end (0);
+
+    while (trieNode != end)
+      {
+        if (cond (*trieNode))
+          {
+            trieNode = recursive_iterator (trieNode->erase ());
+          }
+        trieNode ++;
+      }
+  }
+
+  template<class NameLike>
+  inline std::pair<iterator, bool>
+  insert (const NameLike &key,
+          typename PayloadTraits::insert_type payload)
+  {
+    Allocator &allocator = this->get_allocator ();
+    radix_trie *trieNode = this;
+
+    size_t depth = prefix_.size ();
+    while (depth < key.size ())
+      {
+        std::size_t hash = key.GetPrefixHash (depth + 1);
+        radix_trie *child = trieNode->children_.find (hash, first_equal<NameLike> (key, depth));
+        if (child == 0)
+          {
+            // the rest of the key becomes a single edge
+            radix_trie *newNode = new (allocator.allocate (sizeof (radix_trie))) radix_trie (make_prefix (key), allocator);
+            newNode->parent_ = trieNode;
+            newNode->hash_ = hash;
+
+            trieNode->children_.insert (newNode, hash, allocator);
+            trieNode = newNode;
+            break;
+          }
+
+        size_t childDepth = child->prefix_.size ();
+        size_t index = depth + 1;
+        for (size_t last = std::min (childDepth, key.size ());
+             index < last && KeyTraits::equal_at (key, index, child->prefix_);
+             index ++)
+          ;
+
+        if (index < childDepth)
+          {
+            // key diverges from (or ends within) the edge: split it with the new node
+            child = trieNode->split_edge (child, index, allocator);
+            childDepth = index;
+          }
+
+        trieNode = child;
+        depth = childDepth;
+      }
+
+    if (trieNode->payload_ == PayloadTraits::empty_payload)
+      {
+        trieNode->set_payload (payload);
+        return std::make_pair (trieNode, true);
+      }
+    else
+      return std::make_pair (trieNode, false);
+  }
+
+  /**
+   * @brief Insert many keys in one pass, see trie::bulk_insert
+   *
+   * In sorted input, keys that go below the same new node are adjacent and their common prefix is the
+   * common prefix of the first and the last of them, so every new node is created directly with its
+   * final edge (existing edges are split at most once per group).  Children are presized from the
+   * input fan-out and subtree payload counters are updated once per node
+   */
+  template<class RandomIterator>
+  inline void
+  bulk_insert (RandomIterator begin, RandomIterator end,
+               std::vector< std::pair<iterator, bool> > &results)
+  {
+    results.reserve (results.size () + (end - begin));
+
+    size_t added = bulk_insert_subtree (begin, end, results);
+    if (parent_ != 0)
+      parent_->update_subtree_payloads (added);
+  }
+
+  /**
+   * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
+   */
+  inline iterator
+  erase ()
+  {
+    set_payload (PayloadTraits::empty_payload);
+    return prune ();
+  }
+
+  /**
+   * @brief Do exactly as erase, but without erasing the payload
+   *
+   * Node without payload and with a single child is merged into the child
+   */
+  inline iterator
+  prune ()
+  {
+    if (payload_ != PayloadTraits::empty_payload || parent_ == 0)
+      return this;
+
+    radix_trie *parent = parent_;
+    if (children_.size () == 0)
+      {
+        parent->children_.erase (this, hash_, this->get_allocator ());
+        trie_delete_disposer () (this); // basically, committing a suicide
+
+        return parent->prune ();
+      }
+    else if (children_.size () == 1)
+      {
+        merge_into_child ();
+        return parent;
+      }
+    return this;
+  }
+
+  /**
+   * @brief Perform prune of the node, but without attempting to parent of the node
+   */
+  inline void
+  prune_node ()
+  {
+    if (payload_ != PayloadTraits::empty_payload || parent_ == 0)
+      return;
+
+    if (children_.size () == 0)
+      {
+        parent_->children_.erase (this, hash_, this->get_allocator ());
+        trie_delete_disposer () (this); // basically, committing a suicide
+      }
+    else if (children_.size () == 1)
+      {
+        merge_into_child ();
+      }
+  }
+
+  /**
+   * @brief Perform the longest prefix match
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->third is exactly the key
+   */
+  template<class NameLike>
+  inline boost::tuple<iterator, bool, iterator>
+  find (const NameLike &key)
+  {
+    radix_trie *partial = 0;
+    return walk (key, any_payload (), partial, 0);
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying preficate
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->third is exactly the key
+   */
+  template<class NameLike, class Predicate>
+  inline boost::tuple<iterator, bool, iterator>
+  find_if (const NameLike &key, Predicate pred)
+  {
+    radix_trie *partial = 0;
+    return walk (key, pred, partial, 0);
+  }
+
+  /**
+   * @brief Find all nodes on the path of the key, which payloads satisfy the predicate
+   * @param key the key for which to perform the match
+   * @param matches found nodes are appended, starting from the shortest prefix
+   */
+  template<class NameLike, class Predicate>
+  inline void
+  find_all_if (const NameLike &key, Predicate pred, std::vector<iterator> &matches)
+  {
+    radix_trie *partial = 0;
+    walk (key, pred, partial, &matches);
+  }
+
+  /**
+   * @brief Same as find, but key may also end in the middle of a compressed edge
+   *
+   * @return ->second is true if the key is a prefix of ->third (all nodes with key as a prefix are in the ->third subtree)
+   */
+  template<class NameLike>
+  inline boost::tuple<iterator, bool, iterator>
+  find_subtree (const NameLike &key)
+  {
+    radix_trie *partial = 0;
+    boost::tuple<iterator, bool, iterator> ret = walk (key, any_payload (), partial, 0);
+    if (partial != 0)
+      {
+        boost::get<1> (ret) = true;
+        boost::get<2> (ret) = partial;
+      }
+    return ret;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie
+   *
+   * Follows subtree payload counters, so only one path of O(depth) nodes is visited
+   *
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
+   */
+  inline iterator
+  find ()
+  {
+    if (subtree_payloads_ == 0)
+      return 0;
+
+    radix_trie *trieNode = this;
+    while (trieNode->payload_ == PayloadTraits::empty_payload)
+      {
+        // non-zero counter guarantees that some child has payload in its subtree
+        trieNode = trieNode->skip_empty (trieNode->children_.first ());
+      }
+    return trieNode;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   *
+   * Non-recursive depth-first walk, subtrees without payloads are skipped
+   *
+   * @param pred predicate
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if (Predicate pred)
+  {
+    if (subtree_payloads_ == 0)
+      return 0;
+
+    radix_trie *trieNode = this;
+    while (true)
+      {
+        if (trieNode->payload_ != PayloadTraits::empty_payload && pred (trieNode->payload_))
+          return trieNode;
+
+        radix_trie *next = trieNode->skip_empty (trieNode->children_.first ());
+        while (next == 0)
+          {
+            if (trieNode == this)
+              return 0;
+
+            radix_trie *parent = trieNode->parent_;
+            next = parent->skip_empty (parent->children_.next (trieNode, trieNode->hash_));
+            trieNode = parent;
+          }
+        trieNode = next;
+      }
+  }
+
+  /**
+   * @brief Number of payloads in the sub-trie (including the node itself)
+   */
+  inline size_t
+  subtree_size () const
+  {
+    return subtree_payloads_;
+  }
+
+  iterator end ()
+  {
+    return 0;
+  }
+
+  const_iterator end () const
+  {
+    return 0;
+  }
+
+  typename PayloadTraits::const_return_type
+  payload () const
+  {
+    return payload_;
+  }
+
+  typename PayloadTraits::return_type
+  payload ()
+  {
+    return payload_;
+  }
+
+  void
+  set_payload (typename PayloadTraits::insert_type payload)
+  {
+    bool hadPayload = has_payload ();
+    payload_ = payload;
+    update_subtree_payloads (static_cast<ptrdiff_t> (has_payload ()) - hadPayload);
+  }
+
+  const Key &
+  key () const
+  {
+    return prefix_;
+  }
+
+  /**
+   * @brief Get full key of the node (same as key (), for compatibility with trie)
+   */
+  const FullKey &
+  full_key () const
+  {
+    return prefix_;
+  }
+
+  /**
+   * @brief Get hash of the full key of the node (same as FullKey::GetPrefixHash of the whole key)
+   */
+  std::size_t
+  full_key_hash () const
+  {
+    return prefix_.GetPrefixHash (prefix_.size ());
+  }
+
+  inline void
+  PrintStat (std::ostream &os) const
+  {
+    os << "# " << prefix_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_.size() << " children\n";
+    for (const radix_trie *subnode = children_.first ();
+         subnode != 0;
+         subnode = children_.next (subnode, subnode->hash_))
+      {
+        subnode->PrintStat (os);
+      }
+  }
+
+  /**
+   * @brief Name of the engine, appended to names of tables (e.g., PIT or CS TypeId) that use it
+   */
+  static std::string
+  GetName ()
+  {
+    return "Radix";
+  }
+
+  friend std::ostream &
+  operator << (std::ostream &os, const radix_trie &trie_node)
+  {
+    for (const radix_trie *subnode = trie_node.children_.first ();
+         subnode != 0;
+         subnode = trie_node.children_.next (subnode, subnode->hash_))
+      {
+        os << "\"" << &trie_node << "\"" << " [label=\"" << trie_node.prefix_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]\n";
+        os << "\"" << subnode << "\"" << " [label=\"" << subnode->prefix_ << ((subnode->payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]""\n";
+
+        os << "\"" << &trie_node << "\"" << " -> " << "\"" << subnode << "\"" << "\n";
+        os << *subnode;
+      }
+    return os;
+  }
+
+private:
+  //The disposer object function
+  struct trie_delete_disposer
+  {
+    void operator() (radix_trie *delete_this)
+    {
+      Allocator &allocator = delete_this->get_allocator ();
+      delete_this->~radix_trie ();
+      allocator.deallocate (delete_this, sizeof (radix_trie));
+    }
+  };
+
+  /**
+   * @brief Compare the first component of the edge (at index) with the same component of the key
+   */
+  template<class NameLike>
+  struct first_equal
+  {
+    first_equal (const NameLike &key, size_t index) : key_ (key), index_ (index) { }
+
+    bool operator() (const radix_trie &node) const
+    {
+      return KeyTraits::equal_at (key_, index_, node.prefix_);
+    }
+
+    const NameLike &key_;
+    size_t index_;
+  };
+
+  inline bool
+  has_payload () const
+  {
+    return payload_ != PayloadTraits::empty_payload;
+  }
+
+  /**
+   * @brief Adjust subtree payload counters of the node and all its parents
+   */
+  inline void
+  update_subtree_payloads (ptrdiff_t delta)
+  {
+    if (delta == 0)
+      return;
+
+    for (radix_trie *trieNode = this; trieNode != 0; trieNode = trieNode->parent_)
+      trieNode->subtree_payloads_ += delta;
+  }
+
+  /**
+   * @brief Return the child or the first of its next siblings that has payloads in its subtree
+   */
+  inline radix_trie *
+  skip_empty (radix_trie *subnode)
+  {
+    while (subnode != 0 && subnode->subtree_payloads_ == 0)
+      subnode = children_.next (subnode, subnode->hash_);
+    return subnode;
+  }
+
+  /**
+   * @brief Replace the edge to the child with two edges, the new middle node gets prefix of index components
+   * @returns the middle node
+   */
+  inline radix_trie *
+  split_edge (radix_trie *child, size_t index, Allocator &allocator)
+  {
+    size_t childDepth = child->prefix_.size ();
+
+    radix_trie *middle =
+      new (allocator.allocate (sizeof (radix_trie))) radix_trie (child->prefix_.cut (childDepth - index), allocator);
+    middle->parent_ = this;
+    middle->hash_ = child->hash_;
+    middle->subtree_payloads_ = child->subtree_payloads_;
+
+    children_.erase (child, child->hash_, allocator);
+    children_.insert (middle, middle->hash_, allocator);
+
+    child->parent_ = middle;
+    child->hash_ = child->prefix_.GetPrefixHash (index + 1);
+    middle->children_.insert (child, child->hash_, allocator);
+
+    return middle;
+  }
+
+  /**
+   * @brief Get end of the group of sorted items that have the same component at the index
+   */
+  template<class RandomIterator>
+  static RandomIterator
+  bulk_group_end (size_t index, RandomIterator begin, RandomIterator end)
+  {
+    RandomIterator item = begin;
+    for (item++; item != end && (*item)->first.get (index) == (*begin)->first.get (index); item++)
+      ;
+    return item;
+  }
+
+  /**
+   * @brief Insert sorted items, all of which have prefix of this node
+   * @returns number of new payloads in the subtree (subtree payload counters of parents are not updated)
+   */
+  template<class RandomIterator>
+  size_t
+  bulk_insert_subtree (RandomIterator begin, RandomIterator end,
+                       std::vector< std::pair<iterator, bool> > &results)
+  {
+    typedef typename boost::remove_pointer<typename std::iterator_traits<RandomIterator>::value_type>::type::first_type item_key;
+
+    size_t depth = prefix_.size ();
+    size_t added = 0;
+
+    // keys equal to the prefix of this node go first in sorted order
+    for (; begin != end && (*begin)->first.size () == depth; begin++)
+      {
+        if (payload_ == PayloadTraits::empty_payload)
+          {
+            payload_ = (*begin)->second;
+            added += has_payload ();
+            results.push_back (std::make_pair (this, true));
+          }
+        else
+          results.push_back (std::make_pair (this, false));
+      }
+
+    size_t groups = 0;
+    for (RandomIterator group = begin; group != end; group = bulk_group_end (depth, group, end))
+      groups ++;
+
+    Allocator &allocator = this->get_allocator ();
+    children_.reserve (children_.size () + groups, allocator);
+
+    for (RandomIterator group = begin; group != end; )
+      {
+        RandomIterator groupEnd = bulk_group_end (depth, group, end);
+
+        const item_key &first = (*group)->first;
+        const item_key &last = (*(groupEnd - 1))->first;
+
+        // common prefix of the whole group
+        size_t common = depth + 1;
+        for (size_t size = std::min (first.size (), last.size ());
+             common < size && first.get (common) == last.get (common);
+             common ++)
+          ;
+
+        std::size_t hash = first.GetPrefixHash (depth + 1);
+        radix_trie *child = children_.find (hash, first_equal<item_key> (first, depth));
+        if (child == 0)
+          {
+            child = new (allocator.allocate (sizeof (radix_trie))) radix_trie (make_prefix (first, common), allocator);
+            child->parent_ = this;
+            child->hash_ = hash;
+            children_.insert (child, hash, allocator);
+          }
+        else
+          {
+            size_t childDepth = child->prefix_.size ();
+            size_t index = depth + 1;
+            for (size_t matchEnd = std::min (childDepth, common);
+                 index < matchEnd && KeyTraits::equal_at (first, index, child->prefix_);
+                 index ++)
+              ;
+
+            if (index < childDepth)
+              child = split_edge (child, index, allocator);
+          }
+
+        added += child->bulk_insert_subtree (group, groupEnd, results);
+        group = groupEnd;
+      }
+
+    subtree_payloads_ += added;
+    return added;
+  }
+
+  struct any_payload
+  {
+    template<class Payload>
+    bool operator() (const Payload &) const { return true; }
+  };
+
+  static const FullKey &
+  make_prefix (const FullKey &key)
+  {
+    return key;
+  }
+
+  template<class NameLike>
+  static FullKey
+  make_prefix (const NameLike &key)
+  {
+    return key.ToName ();
+  }
+
+  /**
+   * @brief Make FullKey from the first length components of the key
+   */
+  template<class NameLike>
+  static FullKey
+  make_prefix (const NameLike &key, size_t length)
+  {
+    return make_prefix (key).cut (key.size () - length);
+  }
+
+  /**
+   * @brief Walk down the trie along the key
+   * @param partial set to the child, if the key ends in the middle of its edge
+   * @param matches if not 0, all nodes satisfying the predicate are appended to it
+   */
+  template<class NameLike, class Predicate>
+  inline boost::tuple<iterator, bool, iterator>
+  walk (const NameLike &key, Predicate pred, radix_trie *&partial, std::vector<iterator> *matches)
+  {
+    radix_trie *trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload && pred (payload_)) ? this : 0;
+    if (foundNode != 0 && matches != 0)
+      matches->push_back (foundNode);
+
+    size_t depth = prefix_.size ();
+    while (depth < key.size ())
+      {
+        radix_trie *child = trieNode->children_.find (key.GetPrefixHash (depth + 1), first_equal<NameLike> (key, depth));
+        if (child == 0)
+          return boost::make_tuple (foundNode, false, trieNode);
+
+        size_t childDepth = child->prefix_.size ();
+        size_t last = std::min (childDepth, key.size ());
+        for (size_t index = depth + 1; index < last; index ++)
+          {
+            if (!KeyTraits::equal_at (key, index, child->prefix_))
+              return boost::make_tuple (foundNode, false, trieNode);
+          }
+
+        if (childDepth > key.size ())
+          {
+            partial = child;
+            return boost::make_tuple (foundNode, false, trieNode);
+          }
+
+        trieNode = child;
+        depth = childDepth;
+
+        if (trieNode->payload_ != PayloadTraits::empty_payload &&
+            pred (trieNode->payload_))
+          {
+            foundNode = trieNode;
+            if (matches != 0)
+              matches->push_back (foundNode);
+          }
+      }
+
+    return boost::make_tuple (foundNode, true, trieNode);
+  }
+
+  /**
+   * @brief Replace this node (no payload, exactly one child) with its child
+   */
+  inline void
+  merge_into_child ()
+  {
+    Allocator &allocator = this->get_allocator ();
+    radix_trie *parent = parent_;
+    radix_trie *child = children_.first ();
+
+    children_.erase (child, child->hash_, allocator);
+    parent->children_.erase (this, hash_, allocator);
+
+    child->parent_ = parent;
+    child->hash_ = hash_; // both start with the same component
+    parent->children_.insert (child, child->hash_, allocator);
+
+    trie_delete_disposer () (this);
+  }
+
+public:
+  PolicyHook policy_hook_;
+
+private:
+  typedef detail::trie_children<radix_trie> children_type;
+
+  template<class T, class NonConstT>
+  friend class trie_iterator;
+
+  template<class T>
+  friend class trie_point_iterator;
+
+  ////////////////////////////////////////////////
+  // Actual data
+  ////////////////////////////////////////////////
+
+  FullKey prefix_; ///< full prefix up to (and including) this node
+  std::size_t hash_; ///< hash of the prefix up to the first component of the edge (key in the parent's children_)
+
+  children_type children_; ///< adaptive set of children (nothing is allocated for leaves)
+
+  typename PayloadTraits::storage_type payload_;
+  radix_trie *parent_; // to make cleaning effective
+
+  size_t subtree_payloads_; ///< number of payloads in the subtree (including this node)
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // RADIX_TRIE_H_
@@ -23,8 +23,13 @@
 
 #include "ns3/random-variable.h"
 
+#include "detail/functor-hook.h"
+
 #include <boost/intrusive/options.hpp>
-#include <boost/intrusive/set.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <algorithm>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -32,13 +37,19 @@ namespace ndnSIM {
 
 /**
  * @brief Traits for random replacement policy
+ *
+ * Items are kept in a dense array, and each item remembers its position in the array,
+ * so insert, erase, and eviction of a random item are O(1) (removed item is replaced by the last one)
+ *
+ * The next victim is drawn in advance and kept as the first item, so (as for other replacement
+ * policies) begin () points to the item that will be evicted next, e.g., for admission policies
  */
 struct random_policy_traits
 {
   /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
   static std::string GetName () { return "Random"; }
 
-  struct policy_hook_type : public boost::intrusive::set_member_hook<> { uint32_t randomOrder; };
+  struct policy_hook_type { size_t position; };
 
   template<class Container>
   struct container_hook
@@ -53,41 +64,29 @@ struct random_policy_traits
            class Hook>
   struct policy 
   {
-    static uint32_t& get_order (typename Container::iterator item)
+    static size_t& get_order (typename Container::iterator item)
     {
-      return static_cast<typename policy_container::value_traits::hook_type*>
-        (policy_container::value_traits::to_node_ptr(*item))->randomOrder;
+      return detail::policy_hook<Hook>::get (*item).position;
     }
       
-    static const uint32_t& get_order (typename Container::const_iterator item)
+    static const size_t& get_order (typename Container::const_iterator item)
     {
-      return static_cast<const typename policy_container::value_traits::hook_type*>
-        (policy_container::value_traits::to_node_ptr(*item))->randomOrder;
+      return detail::policy_hook<Hook>::get (*item).position;
     }
     
-    template<class Key>
-    struct MemberHookLess
-    {
-      bool operator () (const Key &a, const Key &b) const
-      {
-        return get_order (&a) < get_order (&b);
-      }
-    };
-
-    typedef boost::intrusive::multiset< Container,
-                                   boost::intrusive::compare< MemberHookLess< Container > >,
-                                   Hook > policy_container;
+    typedef std::vector<Container*> items_container;
     
-    // could be just typedef
-    class type : public policy_container
+    class type
     {
     public:
       typedef policy policy_base; // to get access to get_order methods from outside
       typedef Container parent_trie;
 
+      typedef boost::indirect_iterator<typename items_container::iterator> iterator;
+      typedef boost::indirect_iterator<typename items_container::const_iterator, const Container> const_iterator;
+
       type (Base &base)
         : base_ (base)
-        , u_rand (0, std::numeric_limits<uint32_t>::max ())
         , max_size_ (100)
       {
       }
@@ -101,24 +100,24 @@ struct random_policy_traits
       inline bool
       insert (typename parent_trie::iterator item)
       {
-        get_order (item) = u_rand.GetValue ();
-
-        if (max_size_ != 0 && policy_container::size () >= max_size_)
+        if (max_size_ != 0 && items_.size () >= max_size_)
           {
-            if (MemberHookLess<Container>() (*item, *policy_container::begin ()))
+            // new item has the same chance to be removed as any other one
+            if (u_rand.GetInteger (0, items_.size ()) == items_.size ())
               {
-                // std::cout << "Cannot add. Signaling fail\n";
                 // just return false. Indicating that insert "failed"
                 return false;
               }
             else
               {
-                // removing some random element
-                base_.erase (&(*policy_container::begin ()));
+                // removing pre-drawn random element
+                base_.erase (items_.front ());
               }
           }
 
-        policy_container::insert (*item);
+        get_order (item) = items_.size ();
+        items_.push_back (&(*item));
+        draw_victim ();
         return true;
       }
   
@@ -131,13 +130,49 @@ struct random_policy_traits
       inline void
       erase (typename parent_trie::iterator item)
       {
-        policy_container::erase (policy_container::s_iterator_to (*item));
+        size_t position = get_order (item);
+        Container *last = items_.back ();
+
+        items_[position] = last;
+        get_order (last) = position;
+        items_.pop_back ();
+        draw_victim ();
       }
 
       inline void
       clear ()
       {
-        policy_container::clear ();
+        items_.clear ();
+      }
+
+      inline size_t
+      size () const
+      {
+        return items_.size ();
+      }
+
+      inline iterator
+      begin ()
+      {
+        return iterator (items_.begin ());
+      }
+
+      inline const_iterator
+      begin () const
+      {
+        return const_iterator (items_.begin ());
+      }
+
+      inline iterator
+      end ()
+      {
+        return iterator (items_.end ());
+      }
+
+      inline const_iterator
+      end () const
+      {
+        return const_iterator (items_.end ());
       }
 
       inline void
@@ -154,11 +189,25 @@ struct random_policy_traits
 
     private:
       type () : base_(*((Base*)0)) { };
-      
+
+      inline void
+      draw_victim ()
+      {
+        if (items_.size () < 2)
+          return;
+
+        size_t position = u_rand.GetInteger (0, items_.size () - 1);
+        std::swap (items_.front (), items_[position]);
+        get_order (items_.front ()) = 0;
+        get_order (items_[position]) = position;
+      }
+
     private:
       Base &base_;
       ns3::UniformVariable u_rand;
       size_t max_size_;
+
+      items_container items_;
     };
   };
 };
@@ -0,0 +1,257 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TINYLFU_POLICY_H_
+#define TINYLFU_POLICY_H_
+
+#include "multi-policy.h"
+
+#include <boost/mpl/vector.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Approximate counter of access frequencies (count-min sketch with 4-bit counters)
+ *
+ * Counters are halved after every sample of 10 * width increments (width is the expected number of keys,
+ * rounded up to a power of two), so the estimates reflect recent popularity rather than the whole history.
+ */
+class frequency_sketch
+{
+public:
+  static const size_t DEPTH = 4;
+  static const uint8_t MAX_COUNT = 15;
+
+  frequency_sketch ()
+    : mask_ (0)
+    , sampleSize_ (0)
+    , additions_ (0)
+  {
+  }
+
+  /**
+   * @brief Set size of the sketch, based on the expected number of distinct frequently accessed keys (resets all counters)
+   */
+  inline void
+  resize (size_t expectedSize)
+  {
+    size_t width = 16;
+    while (width < expectedSize)
+      width *= 2;
+
+    mask_ = width - 1;
+    sampleSize_ = 10 * width;
+    additions_ = 0;
+    table_.assign (DEPTH * width, 0);
+  }
+
+  inline void
+  clear ()
+  {
+    additions_ = 0;
+    std::fill (table_.begin (), table_.end (), 0);
+  }
+
+  inline void
+  increment (std::size_t hash)
+  {
+    bool added = false;
+    for (size_t row = 0; row < DEPTH; row++)
+      {
+        uint8_t &counter = table_[row * (mask_ + 1) + index (hash, row)];
+        if (counter < MAX_COUNT)
+          {
+            counter ++;
+            added = true;
+          }
+      }
+
+    if (added && ++additions_ >= sampleSize_)
+      age ();
+  }
+
+  inline uint8_t
+  estimate (std::size_t hash) const
+  {
+    uint8_t count = MAX_COUNT;
+    for (size_t row = 0; row < DEPTH; row++)
+      {
+        count = std::min (count, table_[row * (mask_ + 1) + index (hash, row)]);
+      }
+    return count;
+  }
+
+private:
+  inline size_t
+  index (std::size_t hash, size_t row) const
+  {
+    // each row uses differently mixed hash, so collisions in one row are unlikely to repeat in others
+    uint32_t h = static_cast<uint32_t> (hash ^ (hash >> 16 >> 16)) + static_cast<uint32_t> (row) * 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h & mask_;
+  }
+
+  inline void
+  age ()
+  {
+    for (std::vector<uint8_t>::iterator counter = table_.begin (); counter != table_.end (); counter++)
+      {
+        *counter >>= 1;
+      }
+    additions_ /= 2;
+  }
+
+private:
+  size_t mask_;
+  size_t sampleSize_;
+  size_t additions_;
+  std::vector<uint8_t> table_;
+};
+
+/**
+ * @brief Traits for TinyLFU admission policy
+ *
+ * The policy does not order items by itself and should be combined (as the last policy) with a
+ * replacement policy using multi_policy_traits (see tinylfu_admission_traits).  Frequency of
+ * each insert attempt and each hit is recorded in the frequency sketch.  When the cache is full,
+ * the candidate is admitted only if it is estimated to be more frequently used than the item that the
+ * replacement policy would evict (the first item of the replacement policy, random_policy_traits
+ * draws its victim in advance for this reason), otherwise insert fails.
+ *
+ * Payload must provide GetName () (e.g., content store entries).
+ */
+struct tinylfu_policy_traits
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return "TinyLfu"; }
+
+  typedef void* policy_hook_type;
+
+  template<class Container> struct container_hook { typedef void* type; };
+
+  template<class Base,
+           class Container,
+           class Hook>
+  struct policy
+  {
+    class type
+    {
+    public:
+      typedef Container parent_trie;
+
+      type (Base &base)
+        : base_ (base)
+        , max_size_ (100)
+      {
+        sketch_.resize (max_size_);
+      }
+
+      inline void
+      update (typename parent_trie::iterator item)
+      {
+        // modification of the payload is not an access
+      }
+
+      inline bool
+      insert (typename parent_trie::iterator item)
+      {
+        std::size_t key = get_key (item);
+        sketch_.increment (key);
+
+        if (max_size_ == 0 || base_.getPolicy ().size () < max_size_)
+          return true; // nothing will be evicted
+
+        typename parent_trie::iterator victim = &(*base_.getPolicy ().begin ());
+        return sketch_.estimate (key) > sketch_.estimate (get_key (victim));
+      }
+
+      inline void
+      lookup (typename parent_trie::iterator item)
+      {
+        sketch_.increment (get_key (item));
+      }
+
+      inline void
+      erase (typename parent_trie::iterator item)
+      {
+      }
+
+      inline void
+      clear ()
+      {
+        sketch_.clear ();
+      }
+
+      inline void
+      set_max_size (size_t max_size)
+      {
+        max_size_ = max_size;
+        sketch_.resize (max_size_);
+      }
+
+      inline size_t
+      get_max_size () const
+      {
+        return max_size_;
+      }
+
+    private:
+      type () : base_(*((Base*)0)) { };
+
+      static inline std::size_t
+      get_key (typename parent_trie::iterator item)
+      {
+        return item->payload ()->GetName ().GetPrefixHash (item->payload ()->GetName ().size ());
+      }
+
+    private:
+      Base &base_;
+      size_t max_size_;
+      frequency_sketch sketch_;
+    };
+  };
+};
+
+/**
+ * @brief Replacement policy (e.g., lru_policy_traits) with TinyLFU admission filter in front of it
+ */
+template<class Policy>
+struct tinylfu_admission_traits
+  : public multi_policy_traits< boost::mpl::vector2< Policy, tinylfu_policy_traits > >
+{
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string GetName () { return tinylfu_policy_traits::GetName () + "::" + Policy::GetName (); }
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TINYLFU_POLICY_H_
@@ -0,0 +1,250 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef TRIE_ALLOCATOR_H_
+#define TRIE_ALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Default trie allocator: every node and child array goes directly to the global heap
+ */
+struct heap_allocator
+{
+  inline void *
+  allocate (size_t size)
+  {
+    return ::operator new (size);
+  }
+
+  inline void
+  deallocate (void *ptr, size_t /*size*/)
+  {
+    ::operator delete (ptr);
+  }
+
+  /**
+   * @brief Nothing to release in bulk
+   */
+  inline void
+  release ()
+  {
+  }
+};
+
+/**
+ * @brief Per-table slab allocator for trie nodes and child arrays
+ *
+ * Requests are rounded up to GRANULARITY-byte size classes.  Freed chunks are kept in
+ * per-class free lists and reused by subsequent requests of the same class, so a table
+ * in a steady state (e.g., PIT with constant Interest rate) does not call malloc at all.
+ * Memory is carved from BLOCK_SIZE blocks, which are returned to the system only in bulk,
+ * by release () or when the allocator is destroyed.  Requests larger than MAX_SLAB_SIZE
+ * (e.g., child tables of nodes with very large fan-out) are served by the global heap.
+ */
+class slab_allocator
+{
+public:
+  static const size_t GRANULARITY = 16;
+  static const size_t MAX_SLAB_SIZE = 512;
+  static const size_t BLOCK_SIZE = 64 * 1024;
+
+  slab_allocator ()
+    : current_ (0)
+    , currentEnd_ (0)
+  {
+    for (size_t i = 0; i <= MAX_SLAB_SIZE / GRANULARITY; i++)
+      free_[i] = 0;
+  }
+
+  ~slab_allocator ()
+  {
+    release ();
+  }
+
+  inline void *
+  allocate (size_t size)
+  {
+    if (size > MAX_SLAB_SIZE)
+      return ::operator new (size);
+
+    size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY;
+    if (free_[sizeClass] != 0)
+      {
+        free_chunk *chunk = free_[sizeClass];
+        free_[sizeClass] = chunk->next;
+        return chunk;
+      }
+
+    size_t chunkSize = sizeClass * GRANULARITY;
+    if (current_ + chunkSize > currentEnd_)
+      {
+        current_ = static_cast<char*> (::operator new (BLOCK_SIZE));
+        currentEnd_ = current_ + BLOCK_SIZE;
+        blocks_.push_back (current_);
+      }
+
+    void *ret = current_;
+    current_ += chunkSize;
+    return ret;
+  }
+
+  inline void
+  deallocate (void *ptr, size_t size)
+  {
+    if (size > MAX_SLAB_SIZE)
+      {
+        ::operator delete (ptr);
+        return;
+      }
+
+    size_t sizeClass = (size + GRANULARITY - 1) / GRANULARITY;
+    free_chunk *chunk = static_cast<free_chunk*> (ptr);
+    chunk->next = free_[sizeClass];
+    free_[sizeClass] = chunk;
+  }
+
+  /**
+   * @brief Return all blocks to the system
+   *
+   * Should be called only when there are no outstanding allocations (e.g., after trie is cleared)
+   */
+  void
+  release ()
+  {
+    for (std::vector<char*>::iterator block = blocks_.begin (); block != blocks_.end (); block++)
+      ::operator delete (*block);
+    blocks_.clear ();
+
+    for (size_t i = 0; i <= MAX_SLAB_SIZE / GRANULARITY; i++)
+      free_[i] = 0;
+    current_ = 0;
+    currentEnd_ = 0;
+  }
+
+  /**
+   * @brief Total amount of memory requested from the system (excluding large requests)
+   */
+  inline size_t
+  reserved () const
+  {
+    return blocks_.size () * BLOCK_SIZE;
+  }
+
+private:
+  // non-copyable
+  slab_allocator (const slab_allocator &);
+  slab_allocator &
+  operator= (const slab_allocator &);
+
+  struct free_chunk
+  {
+    free_chunk *next;
+  };
+
+  free_chunk *free_[MAX_SLAB_SIZE / GRANULARITY + 1];
+  char *current_;
+  char *currentEnd_;
+  std::vector<char*> blocks_;
+};
+
+/**
+ * @brief Base class, which makes objects of the derived class allocated from a process-wide slab_allocator
+ *
+ * Used for table entries (e.g., PIT and CS entries), which are reference counted and may outlive the table
+ * that created them, so they cannot be allocated from the table allocator.  Freed objects are recycled by
+ * subsequent allocations of the same size class, and the pool is never returned to the system.
+ *
+ * Derived classes should have a virtual destructor, if objects are deleted through a pointer to a base class
+ */
+template<class T>
+class pool_allocated
+{
+public:
+  static void *
+  operator new (size_t size)
+  {
+    return pool ().allocate (size);
+  }
+
+  static void
+  operator delete (void *ptr, size_t size)
+  {
+    pool ().deallocate (ptr, size);
+  }
+
+private:
+  static slab_allocator &
+  pool ()
+  {
+    // never destroyed, so objects can be freed during static destruction
+    static slab_allocator *allocator = new slab_allocator ();
+    return *allocator;
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Gives trie nodes access to allocator of the table they belong to
+ */
+template<class Allocator>
+class allocator_holder
+{
+public:
+  allocator_holder (Allocator &allocator) : allocator_ (&allocator) { }
+
+  Allocator &
+  get_allocator () const { return *allocator_; }
+
+private:
+  Allocator *allocator_;
+};
+
+/**
+ * @brief Stateless heap allocator does not need to be referenced from each node
+ */
+template<>
+class allocator_holder<heap_allocator>
+{
+public:
+  allocator_holder (heap_allocator &) { }
+
+  heap_allocator &
+  get_allocator () const
+  {
+    static heap_allocator allocator;
+    return allocator;
+  }
+};
+
+} // detail
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TRIE_ALLOCATOR_H_
@@ -23,38 +23,48 @@
 
 #include "trie.h"
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
 template<typename FullKey,
          typename PayloadTraits,
-         typename PolicyTraits
+         typename PolicyTraits,
+         typename KeyTraits = component_key_traits<FullKey>,
+         typename Allocator = heap_allocator,
+         template<typename, typename, typename, typename, typename> class Engine = trie // trie or radix_trie
          >
 class trie_with_policy
 {
 public:
-  typedef trie< FullKey,
-                PayloadTraits,
-                typename PolicyTraits::policy_hook_type > parent_trie;
+  typedef Engine< FullKey,
+                  PayloadTraits,
+                  typename PolicyTraits::policy_hook_type,
+                  KeyTraits,
+                  Allocator > parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::template policy<
-    trie_with_policy<FullKey, PayloadTraits, PolicyTraits>,
+    trie_with_policy<FullKey, PayloadTraits, PolicyTraits, KeyTraits, Allocator, Engine>,
     parent_trie,
     typename PolicyTraits::template container_hook<parent_trie>::type >::type policy_container;
 
   inline
-  trie_with_policy (size_t bucketSize = 10, size_t bucketIncrement = 10)
-    : trie_ ("", bucketSize, bucketIncrement)
+  trie_with_policy ()
+    : trie_ (typename parent_trie::Key (), allocator_)
     , policy_ (*this)
   {
   }
 
+  template<class NameLike>
   inline std::pair< iterator, bool >
-  insert (const FullKey &key, typename PayloadTraits::insert_type payload)
+  insert (const NameLike &key, typename PayloadTraits::insert_type payload)
   {
     std::pair<iterator, bool> item =
       trie_.insert (key, payload);
@@ -76,8 +86,64 @@ public:
     return item;
   }
 
+  /**
+   * @brief Insert many keys at once (e.g., FIB population or cache warm-up)
+   *
+   * Input is sorted by key, so that the trie can be built in a single pass and children of each
+   * node can be presized from the input fan-out.  The policy is then applied to new items in the
+   * input order, exactly as if they were inserted one by one.
+   *
+   * @param first, last range of std::pair<key, payload> (key can be FullKey or any other name-like class)
+   * @param results    if not 0, for each item (in the input order) the same value as would be returned by insert ().
+   *                   Note that with bounded policies, items inserted earlier can be evicted by the later ones
+   */
+  template<class ForwardIterator>
+  inline void
+  bulk_load (ForwardIterator first, ForwardIterator last,
+             std::vector< std::pair<iterator, bool> > *results = 0)
+  {
+    typedef typename std::iterator_traits<ForwardIterator>::value_type value_type;
+
+    std::vector<const value_type*> items;
+    for (; first != last; first++)
+      items.push_back (&(*first));
+
+    std::vector<size_t> order (items.size ());
+    for (size_t i = 0; i < order.size (); i++)
+      order[i] = i;
+    std::stable_sort (order.begin (), order.end (), bulk_key_less<value_type> (items)); // duplicates keep input order
+
+    std::vector<const value_type*> sorted (items.size ());
+    for (size_t i = 0; i < order.size (); i++)
+      sorted[i] = items[order[i]];
+
+    std::vector< std::pair<iterator, bool> > inserted;
+    trie_.bulk_insert (sorted.begin (), sorted.end (), inserted);
+
+    std::vector< std::pair<iterator, bool> > byInput (items.size ());
+    for (size_t i = 0; i < order.size (); i++)
+      byInput[order[i]] = inserted[i];
+
+    for (size_t i = 0; i < byInput.size (); i++)
+      {
+        if (!byInput[i].second)
+          continue;
+
+        bool ok = policy_.insert (s_iterator_to (byInput[i].first));
+        if (!ok)
+          {
+            byInput[i].first->erase (); // cannot insert
+            byInput[i] = std::make_pair (end (), false);
+          }
+      }
+
+    if (results != 0)
+      results->insert (results->end (), byInput.begin (), byInput.end ());
+  }
+
+  template<class NameLike>
   inline void
-  erase (const FullKey &key)
+  erase (const NameLike &key)
   {
     iterator foundItem, lastItem;
     bool reachLast;
@@ -95,14 +161,24 @@ public:
     if (node == end ()) return;
 
     policy_.erase (s_iterator_to (node));
+    PayloadTraits::on_erase (node->payload ());
     node->erase (); // will do cleanup here
   }
 
   inline void
   clear ()
   {
+    // payloads can outlive the trie (e.g., smart pointers held elsewhere), so they are notified the same way as on erase
+    typename parent_trie::recursive_iterator item (trie_), end (0);
+    for (; item != end; item++)
+      {
+        if (item->payload () != PayloadTraits::empty_payload)
+          PayloadTraits::on_erase (item->payload ());
+      }
+
     policy_.clear ();
     trie_.clear ();
+    allocator_.release (); // all nodes are gone, memory can be returned in bulk
   }
 
   template<typename Modifier>
@@ -120,8 +196,9 @@ public:
   /**
    * @brief Find a node that has the exact match with the key
    */
+  template<class NameLike>
   inline iterator
-  find_exact (const FullKey &key)
+  find_exact (const NameLike &key)
   {
     iterator foundItem, lastItem;
     bool reachLast;
@@ -136,8 +213,9 @@ public:
   /**
    * @brief Find a node that has the longest common prefix with key (FIB/PIT lookup)
    */
+  template<class NameLike>
   inline iterator
-  longest_prefix_match (const FullKey &key)
+  longest_prefix_match (const NameLike &key)
   {
     iterator foundItem, lastItem;
     bool reachLast;
@@ -152,9 +230,9 @@ public:
   /**
    * @brief Find a node that has the longest common prefix with key (FIB/PIT lookup)
    */
-  template<class Predicate>
+  template<class NameLike, class Predicate>
   inline iterator
-  longest_prefix_match_if (const FullKey &key, Predicate pred)
+  longest_prefix_match_if (const NameLike &key, Predicate pred)
   {
     iterator foundItem, lastItem;
     bool reachLast;
@@ -166,6 +244,24 @@ public:
     return foundItem;
   }
 
+  /**
+   * @brief Find all nodes that are prefixes of the key and satisfy the predicate, using a single walk (PIT lookup for Data)
+   * @param matches found nodes are appended, starting from the longest prefix
+   */
+  template<class NameLike, class Predicate>
+  inline void
+  all_prefix_matches_if (const NameLike &key, Predicate pred, std::vector<iterator> &matches)
+  {
+    size_t first = matches.size ();
+    trie_.find_all_if (key, pred, matches);
+    std::reverse (matches.begin () + first, matches.end ());
+
+    for (typename std::vector<iterator>::iterator item = matches.begin () + first; item != matches.end (); item++)
+      {
+        policy_.lookup (s_iterator_to (*item));
+      }
+  }
+
   // /**
   //  * @brief Const version of the longest common prefix match
   //  * (semi-const, because there could be update of the policy anyways)
@@ -179,12 +275,13 @@ public:
   /**
    * @brief Find a node that has prefix at least as the key (cache lookup)
    */
+  template<class NameLike>
   inline iterator
-  deepest_prefix_match (const FullKey &key)
+  deepest_prefix_match (const NameLike &key)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    boost::tie (foundItem, reachLast, lastItem) = trie_.find (key);
+    boost::tie (foundItem, reachLast, lastItem) = trie_.find_subtree (key);
 
     // guard in case we don't have anything in the trie
     if (lastItem == trie_.end ())
@@ -194,7 +291,9 @@ public:
       {
         if (foundItem == trie_.end ())
           {
-            foundItem = lastItem->find (); // should be something
+            foundItem = lastItem->find (); // O(depth), guided by subtree payload counters
+            if (foundItem == trie_.end ())
+              return trie_.end ();
           }
         policy_.lookup (s_iterator_to (foundItem));
         return foundItem;
@@ -208,13 +307,13 @@ public:
   /**
    * @brief Find a node that has prefix at least as the key
    */
-  template<class Predicate>
+  template<class NameLike, class Predicate>
   inline iterator
-  deepest_prefix_match (const FullKey &key, Predicate pred)
+  deepest_prefix_match (const NameLike &key, Predicate pred)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    boost::tie (foundItem, reachLast, lastItem) = trie_.find (key);
+    boost::tie (foundItem, reachLast, lastItem) = trie_.find_subtree (key);
 
     // guard in case we don't have anything in the trie
     if (lastItem == trie_.end ())
@@ -253,6 +352,9 @@ public:
   policy_container &
   getPolicy () { return policy_; }
 
+  const Allocator &
+  getAllocator () const { return allocator_; }
+
   static inline iterator
   s_iterator_to (typename parent_trie::iterator item)
   {
@@ -263,6 +365,36 @@ public:
   }
 
 private:
+  /**
+   * @brief Order of keys, in which all keys with the same prefix are adjacent and shorter keys go first
+   */
+  template<class Value>
+  struct bulk_key_less
+  {
+    bulk_key_less (const std::vector<const Value*> &items) : items_ (items) { }
+
+    bool
+    operator() (size_t a, size_t b) const
+    {
+      const typename Value::first_type &keyA = items_[a]->first;
+      const typename Value::first_type &keyB = items_[b]->first;
+
+      size_t size = std::min (keyA.size (), keyB.size ());
+      for (size_t i = 0; i < size; i++)
+        {
+          if (keyA.get (i) < keyB.get (i))
+            return true;
+          if (keyB.get (i) < keyA.get (i))
+            return false;
+        }
+      return keyA.size () < keyB.size ();
+    }
+
+    const std::vector<const Value*> &items_;
+  };
+
+private:
+  Allocator        allocator_; // must be constructed before and destroyed after trie_
   parent_trie      trie_;
   mutable policy_container policy_;
 };
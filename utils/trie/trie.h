@@ -23,14 +23,19 @@
 
 #include "ns3/ptr.h"
 
-#include <boost/intrusive/unordered_set.hpp>
+#include "trie-allocator.h"
+#include "detail/trie-children.h"
+
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/ref.hpp>
+
+#include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -53,6 +58,8 @@ struct pointer_payload_traits
   typedef const BasePayload* const_base_type; // const base type of the entry (when implementation details need to be hidden)
 
   static Payload* empty_payload;
+
+  static void on_erase (Payload *) { } // called just before payload is erased from trie_with_policy
 };
 
 template<typename Payload, typename BasePayload>
@@ -73,6 +80,8 @@ struct smart_pointer_payload_traits
   typedef ns3::Ptr<const BasePayload> const_base_type;
 
   static ns3::Ptr<Payload> empty_payload;
+
+  static void on_erase (const ns3::Ptr<Payload> &) { } // called just before payload is erased from trie_with_policy
 };
 
 template<typename Payload, typename BasePayload>
@@ -93,6 +102,8 @@ struct non_pointer_traits
   typedef const BasePayload& const_base_type;
 
   static Payload empty_payload;
+
+  static void on_erase (const Payload &) { } // called just before payload is erased from trie_with_policy
 };
 
 template<typename Payload, typename BasePayload>
@@ -100,27 +111,56 @@ Payload
 non_pointer_traits<Payload, BasePayload>::empty_payload = Payload ();
 
 
+/////////////////////////////////////////////////////
+// Allow customization of keys stored in trie nodes
+//
+// Lookup and insert operations accept FullKey or any other name-like class (e.g., PrefixView)
+// that provides size (), get (index), and GetPrefixHash (length)
+//
+/**
+ * @brief Trie nodes keep copies of FullKey components (FullKey::partial_type), child lookups compare bytes
+ */
+template<typename FullKey>
+struct component_key_traits
+{
+  typedef typename FullKey::partial_type key_type; // what is stored in the trie node
+
+  template<class NameLike>
+  static key_type
+  make_key (const NameLike &key, size_t index) { return key_type (key.get (index)); }
+
+  template<class NameLike>
+  static bool
+  equal (const NameLike &key, size_t index, const key_type &nodeKey) { return key.get (index) == nodeKey; }
+
+  template<class NameLike>
+  static bool
+  equal_at (const NameLike &key, size_t index, const FullKey &prefix) { return key.get (index) == prefix.get (index); }
+};
+
 ////////////////////////////////////////////////////
 // forward declarations
 //
 template<typename FullKey,
          typename PayloadTraits,
-         typename PolicyHook >
+         typename PolicyHook,
+         typename KeyTraits = component_key_traits<FullKey>,
+         typename Allocator = heap_allocator>
 class trie;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 inline std::ostream&
 operator << (std::ostream &os,
-             const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+             const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &trie_node);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 bool
-operator== (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-            const trie<FullKey, PayloadTraits, PolicyHook> &b);
+operator== (const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &a,
+            const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &b);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook >
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 std::size_t
-hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+hash_value (const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &trie_node);
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -133,11 +173,13 @@ class trie_point_iterator;
 
 template<typename FullKey,
 	 typename PayloadTraits,
-         typename PolicyHook >
-class trie
+         typename PolicyHook,
+         typename KeyTraits,
+         typename Allocator >
+class trie : private detail::allocator_holder<Allocator>
 {
 public:
-  typedef typename FullKey::partial_type Key;
+  typedef typename KeyTraits::key_type Key;
 
   typedef trie*       iterator;
   typedef const trie* const_iterator;
@@ -149,17 +191,21 @@ public:
   typedef trie_point_iterator<const trie> const_point_iterator;
 
   typedef PayloadTraits payload_traits;
+  typedef Allocator allocator_type;
 
+  /**
+   * @brief Create root of the trie
+   * @param key       key of the root node
+   * @param allocator allocator for all nodes of the trie (must outlive the trie)
+   */
   inline
-  trie (const Key &key, size_t bucketSize = 10, size_t bucketIncrement = 10)
-    : key_ (key)
-    , initialBucketSize_ (bucketSize)
-    , bucketIncrement_ (bucketIncrement)
-    , bucketSize_ (initialBucketSize_)
-    , buckets_ (new bucket_type [bucketSize_]) //cannot use normal pointer, because lifetime of buckets should be larger than lifetime of the container
-    , children_ (bucket_traits (buckets_.get (), bucketSize_))
+  trie (const Key &key, Allocator &allocator)
+    : detail::allocator_holder<Allocator> (allocator)
+    , key_ (key)
+    , hash_ (0)
     , payload_ (PayloadTraits::empty_payload)
     , parent_ (0)
+    , subtree_payloads_ (0)
   {
   }
 
@@ -167,13 +213,14 @@ public:
   ~trie ()
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
-    children_.clear_and_dispose (trie_delete_disposer ());
+    children_.clear_and_dispose (trie_delete_disposer (), this->get_allocator ());
   }
 
   void
   clear ()
   {
-    children_.clear_and_dispose (trie_delete_disposer ());
+    update_subtree_payloads (-static_cast<ptrdiff_t> (subtree_payloads_ - has_payload ()));
+    children_.clear_and_dispose (trie_delete_disposer (), this->get_allocator ());
   }
 
   template<class Predicate>
@@ -195,62 +242,69 @@ public:
 
   // actual entry
   friend bool
-  operator== <> (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-                 const trie<FullKey, PayloadTraits, PolicyHook> &b);
+  operator== <> (const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &a,
+                 const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &b);
 
   friend std::size_t
-  hash_value <> (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node);
+  hash_value <> (const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &trie_node);
 
+  template<class NameLike>
   inline std::pair<iterator, bool>
-  insert (const FullKey &key,
+  insert (const NameLike &key,
           typename PayloadTraits::insert_type payload)
   {
     trie *trieNode = this;
 
-    BOOST_FOREACH (const Key &subkey, key)
+    for (size_t index = 0; index < key.size (); index++)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
+        std::size_t hash = key.GetPrefixHash (index + 1);
+        trie *item = trieNode->children_.find (hash, key_equal<NameLike> (key, index));
+        if (item == 0)
           {
-            trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
+            Allocator &allocator = this->get_allocator ();
+            trie *newNode = new (allocator.allocate (sizeof (trie))) trie (KeyTraits::make_key (key, index), allocator);
             // std::cout << "new " << newNode << "\n";
             newNode->parent_ = trieNode;
+            newNode->hash_ = hash;
 
-            if (trieNode->children_.size () >= trieNode->bucketSize_)
-              {
-                trieNode->bucketSize_ += trieNode->bucketIncrement_;
-                trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-                buckets_array newBuckets (new bucket_type [trieNode->bucketSize_]);
-                trieNode->children_.rehash (bucket_traits (newBuckets.get (), trieNode->bucketSize_));
-                trieNode->buckets_.swap (newBuckets);
-              }
-
-            std::pair< typename unordered_set::iterator, bool > ret =
-              trieNode->children_.insert (*newNode);
-
-            trieNode = &(*ret.first);
+            trieNode->children_.insert (newNode, hash, allocator);
+            trieNode = newNode;
           }
         else
-          trieNode = &(*item);
+          trieNode = item;
       }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload)
       {
-        trieNode->payload_ = payload;
+        trieNode->set_payload (payload);
         return std::make_pair (trieNode, true);
       }
     else
       return std::make_pair (trieNode, false);
   }
 
+  /**
+   * @brief Insert many keys in one pass, children of every node are presized from the input fan-out
+   * @param begin, end range of pointers to std::pair<key, payload>, sorted by key (see trie_with_policy::bulk_load)
+   * @param results    for each item (in the same order) the node and whether the payload was set,
+   *                   exactly as would be returned by insert ()
+   */
+  template<class RandomIterator>
+  inline void
+  bulk_insert (RandomIterator begin, RandomIterator end,
+               std::vector< std::pair<iterator, bool> > &results)
+  {
+    results.reserve (results.size () + (end - begin));
+    bulk_insert_subtree (0, begin, end, results);
+  }
+
   /**
    * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
    */
   inline iterator
   erase ()
   {
-    payload_ = PayloadTraits::empty_payload;
+    set_payload (PayloadTraits::empty_payload);
     return prune ();
   }
 
@@ -266,7 +320,8 @@ public:
         if (parent_ == 0) return this;
 
         trie *parent = parent_;
-        parent->children_.erase_and_dispose (*this, trie_delete_disposer ()); // delete this; basically, committing a suicide
+        parent->children_.erase (this, hash_, this->get_allocator ());
+        trie_delete_disposer () (this); // basically, committing a suicide
 
         return parent->prune ();
       }
@@ -285,7 +340,8 @@ public:
         if (parent_ == 0) return;
 
         trie *parent = parent_;
-        parent->children_.erase_and_dispose (*this, trie_delete_disposer ()); // delete this; basically, committing a suicide
+        parent->children_.erase (this, hash_, this->get_allocator ());
+        trie_delete_disposer () (this); // basically, committing a suicide
       }
   }
 
@@ -301,24 +357,25 @@ public:
    *
    * @return ->second is true if prefix in ->first is longer than key
    */
+  template<class NameLike>
   inline boost::tuple<iterator, bool, iterator>
-  find (const FullKey &key)
+  find (const NameLike &key)
   {
     trie *trieNode = this;
     iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
     bool reachLast = true;
 
-    BOOST_FOREACH (const Key &subkey, key)
+    for (size_t index = 0; index < key.size (); index++)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
+        trie *item = trieNode->children_.find (key.GetPrefixHash (index + 1), key_equal<NameLike> (key, index));
+        if (item == 0)
           {
             reachLast = false;
             break;
           }
         else
           {
-            trieNode = &(*item);
+            trieNode = item;
 
             if (trieNode->payload_ != PayloadTraits::empty_payload)
               foundNode = trieNode;
@@ -334,25 +391,25 @@ public:
    *
    * @return ->second is true if prefix in ->first is longer than key
    */
-  template<class Predicate>
+  template<class NameLike, class Predicate>
   inline boost::tuple<iterator, bool, iterator>
-  find_if (const FullKey &key, Predicate pred)
+  find_if (const NameLike &key, Predicate pred)
   {
     trie *trieNode = this;
     iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
     bool reachLast = true;
 
-    BOOST_FOREACH (const Key &subkey, key)
+    for (size_t index = 0; index < key.size (); index++)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
-        if (item == trieNode->children_.end ())
+        trie *item = trieNode->children_.find (key.GetPrefixHash (index + 1), key_equal<NameLike> (key, index));
+        if (item == 0)
           {
             reachLast = false;
             break;
           }
         else
           {
-            trieNode = &(*item);
+            trieNode = item;
 
             if (trieNode->payload_ != PayloadTraits::empty_payload &&
                 pred (trieNode->payload_))
@@ -365,32 +422,73 @@ public:
     return boost::make_tuple (foundNode, reachLast, trieNode);
   }
 
+  /**
+   * @brief Find all nodes on the path of the key, which payloads satisfy the predicate
+   * @param key the key for which to perform the match
+   * @param matches found nodes are appended, starting from the shortest prefix
+   */
+  template<class NameLike, class Predicate>
+  inline void
+  find_all_if (const NameLike &key, Predicate pred, std::vector<iterator> &matches)
+  {
+    trie *trieNode = this;
+    if (payload_ != PayloadTraits::empty_payload && pred (payload_))
+      matches.push_back (this);
+
+    for (size_t index = 0; index < key.size (); index++)
+      {
+        trieNode = trieNode->children_.find (key.GetPrefixHash (index + 1), key_equal<NameLike> (key, index));
+        if (trieNode == 0)
+          break;
+
+        if (trieNode->payload_ != PayloadTraits::empty_payload &&
+            pred (trieNode->payload_))
+          {
+            matches.push_back (trieNode);
+          }
+      }
+  }
+
+  /**
+   * @brief Same as find (key). Path-compressed tries (radix_trie) also report when the key ends
+   *        inside an edge, for trie nodes always end on component boundary
+   *
+   * @return ->second is true if the key is a prefix of ->third (all nodes with key as a prefix are in the ->third subtree)
+   */
+  template<class NameLike>
+  inline boost::tuple<iterator, bool, iterator>
+  find_subtree (const NameLike &key)
+  {
+    return find (key);
+  }
+
   /**
    * @brief Find next payload of the sub-trie
+   *
+   * Follows subtree payload counters, so only one path of O(depth) nodes is visited
+   *
    * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
    */
   inline iterator
   find ()
   {
-    if (payload_ != PayloadTraits::empty_payload)
-      return this;
+    if (subtree_payloads_ == 0)
+      return 0;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin ();
-         subnode != children_.end ();
-         subnode++ )
-      // BOOST_FOREACH (trie &subnode, children_)
+    trie *trieNode = this;
+    while (trieNode->payload_ == PayloadTraits::empty_payload)
       {
-        iterator value = subnode->find ();
-        if (value != 0)
-          return value;
+        // non-zero counter guarantees that some child has payload in its subtree
+        trieNode = trieNode->skip_empty (trieNode->children_.first ());
       }
-
-    return 0;
+    return trieNode;
   }
 
   /**
    * @brief Find next payload of the sub-trie satisfying the predicate
+   *
+   * Non-recursive depth-first walk, subtrees without payloads are skipped
+   *
    * @param pred predicate
    * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration )
    */
@@ -398,21 +496,36 @@ public:
   inline const iterator
   find_if (Predicate pred)
   {
-    if (payload_ != PayloadTraits::empty_payload && pred (payload_))
-      return this;
+    if (subtree_payloads_ == 0)
+      return 0;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin ();
-         subnode != children_.end ();
-         subnode++ )
-      // BOOST_FOREACH (const trie &subnode, children_)
+    trie *trieNode = this;
+    while (true)
       {
-        iterator value = subnode->find_if (pred);
-        if (value != 0)
-          return value;
+        if (trieNode->payload_ != PayloadTraits::empty_payload && pred (trieNode->payload_))
+          return trieNode;
+
+        trie *next = trieNode->skip_empty (trieNode->children_.first ());
+        while (next == 0)
+          {
+            if (trieNode == this)
+              return 0;
+
+            trie *parent = trieNode->parent_;
+            next = parent->skip_empty (parent->children_.next (trieNode, trieNode->hash_));
+            trieNode = parent;
+          }
+        trieNode = next;
       }
+  }
 
-    return 0;
+  /**
+   * @brief Number of payloads in the sub-trie (including the node itself)
+   */
+  inline size_t
+  subtree_size () const
+  {
+    return subtree_payloads_;
   }
 
   iterator end ()
@@ -440,7 +553,9 @@ public:
   void
   set_payload (typename PayloadTraits::insert_type payload)
   {
+    bool hadPayload = has_payload ();
     payload_ = payload;
+    update_subtree_payloads (static_cast<ptrdiff_t> (has_payload ()) - hadPayload);
   }
 
   Key key () const
@@ -448,28 +563,175 @@ public:
     return key_;
   }
 
+  /**
+   * @brief Restore full key of the node from the keys of all nodes on the path from the root
+   *
+   * Requires keys that can be converted back to FullKey (component_key_traits)
+   */
+  FullKey
+  full_key () const
+  {
+    std::list<boost::reference_wrapper<const Key> > keys;
+    for (const trie *trieNode = this; trieNode->parent_ != 0; trieNode = trieNode->parent_)
+      keys.push_front (boost::cref (trieNode->key_));
+
+    return FullKey (keys);
+  }
+
+  /**
+   * @brief Get hash of the full key of the node (same as FullKey::GetPrefixHash of the whole key)
+   */
+  std::size_t
+  full_key_hash () const
+  {
+    return hash_;
+  }
+
   inline void
   PrintStat (std::ostream &os) const;
 
+  /**
+   * @brief Name of the engine, appended to names of tables (e.g., PIT or CS TypeId) that use it
+   *
+   * Empty for the default engine
+   */
+  static std::string
+  GetName ()
+  {
+    return "";
+  }
+
 private:
   //The disposer object function
   struct trie_delete_disposer
   {
     void operator() (trie *delete_this)
     {
-      delete delete_this;
+      Allocator &allocator = delete_this->get_allocator ();
+      delete_this->~trie ();
+      allocator.deallocate (delete_this, sizeof (trie));
     }
   };
 
-  template<class D>
-  struct array_disposer
+  /**
+   * @brief Compare component of FullKey (specified by index) with key of the trie node
+   *
+   * Children are looked up by precomputed hash of the prefix (FullKey::GetPrefixHash),
+   * so the comparison is invoked only for nodes with matching hash
+   */
+  template<class NameLike>
+  struct key_equal
   {
-    void operator() (D *array)
+    key_equal (const NameLike &key, size_t index) : key_ (key), index_ (index) { }
+
+    bool operator() (const trie &node) const
     {
-      delete [] array;
+      return KeyTraits::equal (key_, index_, node.key_);
     }
+
+    const NameLike &key_;
+    size_t index_;
   };
 
+  inline bool
+  has_payload () const
+  {
+    return payload_ != PayloadTraits::empty_payload;
+  }
+
+  /**
+   * @brief Adjust subtree payload counters of the node and all its parents
+   */
+  inline void
+  update_subtree_payloads (ptrdiff_t delta)
+  {
+    if (delta == 0)
+      return;
+
+    for (trie *trieNode = this; trieNode != 0; trieNode = trieNode->parent_)
+      trieNode->subtree_payloads_ += delta;
+  }
+
+  /**
+   * @brief Return the child or the first of its next siblings that has payloads in its subtree
+   */
+  inline trie *
+  skip_empty (trie *subnode)
+  {
+    while (subnode != 0 && subnode->subtree_payloads_ == 0)
+      subnode = children_.next (subnode, subnode->hash_);
+    return subnode;
+  }
+
+  /**
+   * @brief Get end of the group of sorted items that have the same component at the index
+   */
+  template<class RandomIterator>
+  static RandomIterator
+  bulk_group_end (size_t index, RandomIterator begin, RandomIterator end)
+  {
+    RandomIterator item = begin;
+    for (item++; item != end && (*item)->first.get (index) == (*begin)->first.get (index); item++)
+      ;
+    return item;
+  }
+
+  /**
+   * @brief Insert sorted items, all of which have prefix of this node (of depth components)
+   */
+  template<class RandomIterator>
+  void
+  bulk_insert_subtree (size_t depth, RandomIterator begin, RandomIterator end,
+                       std::vector< std::pair<iterator, bool> > &results)
+  {
+    // keys equal to the prefix of this node go first in sorted order
+    for (; begin != end && (*begin)->first.size () == depth; begin++)
+      {
+        if (payload_ == PayloadTraits::empty_payload)
+          {
+            set_payload ((*begin)->second);
+            results.push_back (std::make_pair (this, true));
+          }
+        else
+          results.push_back (std::make_pair (this, false));
+      }
+
+    if (begin == end)
+      return;
+
+    size_t groups = 0;
+    for (RandomIterator group = begin; group != end; group = bulk_group_end (depth, group, end))
+      groups ++;
+
+    Allocator &allocator = this->get_allocator ();
+    children_.reserve (children_.size () + groups, allocator);
+
+    for (RandomIterator group = begin; group != end; )
+      {
+        RandomIterator groupEnd = bulk_group_end (depth, group, end);
+
+        trie *child = find_or_create_child ((*group)->first, depth, allocator);
+        child->bulk_insert_subtree (depth + 1, group, groupEnd, results);
+        group = groupEnd;
+      }
+  }
+
+  template<class NameLike>
+  inline trie *
+  find_or_create_child (const NameLike &key, size_t index, Allocator &allocator)
+  {
+    std::size_t hash = key.GetPrefixHash (index + 1);
+    trie *child = children_.find (hash, key_equal<NameLike> (key, index));
+    if (child == 0)
+      {
+        child = new (allocator.allocate (sizeof (trie))) trie (KeyTraits::make_key (key, index), allocator);
+        child->parent_ = this;
+        child->hash_ = hash;
+        children_.insert (child, hash, allocator);
+      }
+    return child;
+  }
+
   friend
   std::ostream&
   operator<< < > (std::ostream &os, const trie &trie_node);
@@ -478,17 +740,9 @@ public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
   // necessary typedefs
   typedef trie self_type;
-  typedef boost::intrusive::member_hook< trie,
-                                         boost::intrusive::unordered_set_member_hook< >,
-                                         &trie::unordered_set_member_hook_ > member_hook;
-
-  typedef boost::intrusive::unordered_set< trie, member_hook > unordered_set;
-  typedef typename unordered_set::bucket_type   bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
+  typedef detail::trie_children<trie> children_type;
 
   template<class T, class NonConstT>
   friend class trie_iterator;
@@ -501,33 +755,29 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
+  std::size_t hash_; ///< hash of the full prefix up to (and including) this node
 
-  size_t initialBucketSize_;
-  size_t bucketIncrement_;
-
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr< bucket_type, array_disposer<bucket_type> > buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  children_type children_; ///< adaptive set of children (nothing is allocated for leaves)
 
   typename PayloadTraits::storage_type payload_;
   trie *parent_; // to make cleaning effective
+
+  size_t subtree_payloads_; ///< number of payloads in the subtree (including this node)
 };
 
 
 
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 inline std::ostream&
-operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &trie_node)
 {
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin ();
-       subnode != trie_node.children_.end ();
-       subnode++ )
-  // BOOST_FOREACH (const trie &subnode, trie_node.children_)
+  for (const trie *subnode = trie_node.children_.first ();
+       subnode != 0;
+       subnode = trie_node.children_.next (subnode, subnode->hash_))
     {
       os << "\"" << &trie_node << "\"" << " [label=\"" << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]\n";
       os << "\"" << &(*subnode) << "\"" << " [label=\"" << subnode->key_ << ((subnode->payload_ != PayloadTraits::empty_payload)?"*":"") << "\"]""\n";
@@ -539,44 +789,40 @@ operator << (std::ostream &os, const trie<FullKey, PayloadTraits, PolicyHook> &t
   return os;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 inline void
-trie<FullKey, PayloadTraits, PolicyHook>
+trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator>
 ::PrintStat (std::ostream &os) const
 {
-  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count ();
-       bucket < maxbucket;
-       bucket++)
-    {
-      os << " " << children_.bucket_size (bucket);
-    }
+  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload)?"*":"") << ": " << children_.size() << " children";
+  if (children_.capacity () == 0)
+    os << " (inline)";
+  else
+    os << (children_.is_hashed () ? " (hash table, " : " (sorted array, ") << children_.capacity () << " slots)";
   os << "\n";
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin ();
-       subnode != children_.end ();
-       subnode++ )
-  // BOOST_FOREACH (const trie &subnode, children_)
+  for (const trie *subnode = children_.first ();
+       subnode != 0;
+       subnode = children_.next (subnode, subnode->hash_))
     {
       subnode->PrintStat (os);
     }
 }
 
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 inline bool
-operator == (const trie<FullKey, PayloadTraits, PolicyHook> &a,
-             const trie<FullKey, PayloadTraits, PolicyHook> &b)
+operator == (const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &a,
+             const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &b)
 {
   return a.key_ == b.key_;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits, typename Allocator>
 inline std::size_t
-hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
+hash_value (const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits, Allocator> &trie_node)
 {
-  return boost::hash_value (trie_node.key_);
+  return trie_node.hash_;
 }
 
 
@@ -602,7 +848,7 @@ public:
   operator++ (int)
   {
     if (trie_->children_.size () > 0)
-      trie_ = &(*trie_->children_.begin ());
+      trie_ = trie_->children_.first ();
     else
       trie_ = goUp ();
     return *this;
@@ -616,20 +862,14 @@ public:
   }
 
 private:
-  typedef typename boost::mpl::if_< boost::is_same<Trie, NonConstTrie>,
-                                    typename Trie::unordered_set::iterator,
-                                    typename Trie::unordered_set::const_iterator>::type set_iterator;
-
   Trie* goUp ()
   {
     if (trie_->parent_ != 0)
       {
-        // typename Trie::unordered_set::iterator item =
-        set_iterator item = const_cast<NonConstTrie*>(trie_)->parent_->children_.iterator_to (const_cast<NonConstTrie&> (*trie_));
-        item++;
-        if (item != trie_->parent_->children_.end ())
+        Trie *item = trie_->parent_->children_.next (trie_, trie_->hash_);
+        if (item != 0)
           {
-            return &(*item);
+            return item;
           }
         else
           {
@@ -648,20 +888,12 @@ private:
 template<class Trie>
 class trie_point_iterator
 {
-private:
-  typedef typename boost::mpl::if_< boost::is_same<Trie, const Trie>,
-                                    typename Trie::unordered_set::const_iterator,
-                                    typename Trie::unordered_set::iterator>::type set_iterator;
-
 public:
   trie_point_iterator () : trie_ (0) {}
   trie_point_iterator (typename Trie::iterator item) : trie_ (item) {}
   trie_point_iterator (Trie &item)
   {
-    if (item.children_.size () != 0)
-      trie_ = &*item.children_.begin ();
-    else
-      trie_ = 0;
+    trie_ = item.children_.first ();
   }
 
   Trie & operator* () { return *trie_; }
@@ -678,12 +910,7 @@ public:
   {
     if (trie_->parent_ != 0)
       {
-        set_iterator item = trie_->parent_->children_.iterator_to (*trie_);
-        item ++;
-        if (item == trie_->parent_->children_.end ())
-          trie_ = 0;
-        else
-          trie_ = &*item;
+        trie_ = trie_->parent_->children_.next (trie_, trie_->hash_);
       }
     else
       {